@@ -1,12 +1,25 @@
 #include "CollisionEvent.h"
 
+static_assert(sizeof(CollisionEvent) == sizeof(Event), "CollisionEvent keeps its data in the event payload");
+
+// Packs both object IDs into the inline payload
+static EventPayload makeCollisionPayload(int object1ID, int object2ID) {
+    EventPayload payload = {};
+    payload.collision.object1ID = object1ID;
+    payload.collision.object2ID = object2ID;
+    return payload;
+}
+
 CollisionEvent::CollisionEvent(int object1ID, int object2ID, Timeline* timeline)
-    : Event(COLLISION, 1, timeline), object1ID(object1ID), object2ID(object2ID) {}
+    : Event(COLLISION, 1, timeline, makeCollisionPayload(object1ID, object2ID)) {}
+
+CollisionEvent::CollisionEvent(const Event& event)
+    : Event(event) {}
 
 int CollisionEvent::getObject1ID() const {
-    return object1ID;
+    return getPayload().collision.object1ID;
 }
 
 int CollisionEvent::getObject2ID() const {
-    return object2ID;
+    return getPayload().collision.object2ID;
 }
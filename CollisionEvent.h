@@ -21,6 +21,13 @@ public:
      */
     CollisionEvent(int object1ID, int object2ID, Timeline* timeline);
 
+    /**
+     * @brief Views a dispatched event as a CollisionEvent.
+     *
+     * @param event An event whose type is COLLISION.
+     */
+    explicit CollisionEvent(const Event& event);
+
     /**
      * @brief Gets the ID of the first object involved in the collision.
      *
@@ -34,10 +41,6 @@ public:
      * @return int The ID of the second object.
      */
     int getObject2ID() const;
-
-private:
-    int object1ID; // ID of the first object involved in the collision.
-    int object2ID; // ID of the second object involved in the collision.
 };
 
 #endif // COLLISION_EVENT_H
@@ -0,0 +1,339 @@
+#ifndef COMPONENT_STORAGE_H
+#define COMPONENT_STORAGE_H
+
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include "Entity.h"
+
+/**
+ * @brief Type-erased interface for a single component array.
+ *
+ * The PropertyManager keeps one storage per property type. Operations that do not need
+ * to know the concrete property type (such as destroying an object) go through this interface.
+ */
+class IComponentStorage {
+public:
+    virtual ~IComponentStorage() = default;
+
+    /**
+     * @brief Check whether an object has a component in this storage.
+     * @param objectID The ID of the object.
+     * @return True if the object has a component, false otherwise.
+     */
+    virtual bool has(int objectID) const = 0;
+
+    /**
+     * @brief Remove the component belonging to an object, if any.
+     * @param objectID The ID of the object.
+     */
+    virtual void remove(int objectID) = 0;
+
+    /**
+     * @brief Add or replace a component from an untyped pointer to its value.
+     * @param objectID The ID of the object.
+     * @param component Pointer to a component of the storage's type.
+     * @param version The change version to stamp on the component.
+     */
+    virtual void insertRaw(int objectID, const void* component, uint32_t version) = 0;
+
+    /**
+     * @brief Add or replace the same component value for many objects in one batch.
+     * @param objectIDs The IDs of the objects.
+     * @param count The number of objects.
+     * @param component Pointer to a component of the storage's type.
+     * @param version The change version to stamp on the components.
+     */
+    virtual void insertBatchRaw(const int* objectIDs, size_t count, const void* component, uint32_t version) = 0;
+
+    /**
+     * @brief Get the number of components currently stored.
+     * @return The number of components.
+     */
+    virtual size_t size() const = 0;
+
+    /**
+     * @brief Get the size in bytes of one component.
+     * @return The component size.
+     */
+    virtual size_t getComponentSize() const = 0;
+
+    /**
+     * @brief Get the number of object slots covered by the sparse index.
+     * @return The sparse index size.
+     */
+    virtual size_t getSparseSize() const = 0;
+
+    /**
+     * @brief Copy the packed arrays and sparse index out as raw memory.
+     *
+     * The destinations must have room for size() components, object IDs and versions, and for
+     * getSparseSize() sparse entries.
+     */
+    virtual void copyRaw(void* components, int* objectIDs, uint32_t* versions, int* sparse) const = 0;
+
+    /**
+     * @brief Replace the whole storage with raw arrays, as written by copyRaw().
+     * @param components Pointer to count packed components of the storage's type.
+     * @param objectIDs Pointer to count object IDs.
+     * @param versions Pointer to count change versions.
+     * @param count The number of components.
+     * @param sparse Pointer to sparseSize sparse index entries.
+     * @param sparseSize The number of sparse index entries.
+     */
+    virtual void assignRaw(const void* components, const int* objectIDs, const uint32_t* versions, size_t count,
+        const int* sparse, size_t sparseSize) = 0;
+};
+
+/**
+ * @brief Dense, contiguous storage for all components of one property type.
+ *
+ * Components are kept by value in a packed array so iterating every component of a type is a
+ * linear walk. A sparse index maps each object's slot index to a position in the packed array, and
+ * removal moves the last component into the freed position so the array never has holes. Lookups
+ * compare the full generational ID, so a stale ID never sees the component of a recycled slot.
+ * Every component also carries the change version at which it was last added or marked changed,
+ * so systems can find just the components that changed since a version they recorded earlier.
+ *
+ * The class is final so typed calls through a ComponentStorage<T> are resolved without virtual dispatch.
+ */
+template <typename T>
+class ComponentStorage final : public IComponentStorage {
+public:
+    /**
+     * @brief Add or replace the component for an object.
+     * @param objectID The ID of the object.
+     * @param component The component value to store.
+     * @param version The change version to stamp on the component.
+     * @return A reference to the stored component.
+     */
+    T& insert(int objectID, const T& component, uint32_t version) {
+        int slot = Entity::getIndex(objectID);
+        if (slot >= static_cast<int>(sparse.size())) {
+            sparse.resize(slot + 1, INVALID_INDEX);
+        }
+
+        int index = sparse[slot];
+        if (index != INVALID_INDEX) {
+            components[index] = component;  // Replace the existing component in place
+            versions[index] = version;
+            return components[index];
+        }
+
+        sparse[slot] = static_cast<int>(components.size());
+        components.push_back(component);
+        objectIDs.push_back(objectID);
+        versions.push_back(version);
+        return components.back();
+    }
+
+    /**
+     * @brief Get the component for an object.
+     * @param objectID The ID of the object.
+     * @return A pointer to the component if found, nullptr otherwise.
+     */
+    T* get(int objectID) {
+        int index = indexOf(objectID);
+        return index != INVALID_INDEX ? &components[index] : nullptr;
+    }
+
+    /**
+     * @brief Get the component for an object (read-only).
+     * @param objectID The ID of the object.
+     * @return A pointer to the component if found, nullptr otherwise.
+     */
+    const T* get(int objectID) const {
+        int index = indexOf(objectID);
+        return index != INVALID_INDEX ? &components[index] : nullptr;
+    }
+
+    bool has(int objectID) const override {
+        return indexOf(objectID) != INVALID_INDEX;
+    }
+
+    void remove(int objectID) override {
+        int index = indexOf(objectID);
+        if (index == INVALID_INDEX) {
+            return;
+        }
+
+        // Move the last component into the freed slot to keep the array packed
+        int last = static_cast<int>(components.size()) - 1;
+        if (index != last) {
+            components[index] = components[last];
+            objectIDs[index] = objectIDs[last];
+            versions[index] = versions[last];
+            sparse[Entity::getIndex(objectIDs[index])] = index;
+        }
+
+        components.pop_back();
+        objectIDs.pop_back();
+        versions.pop_back();
+        sparse[Entity::getIndex(objectID)] = INVALID_INDEX;
+    }
+
+    void insertRaw(int objectID, const void* component, uint32_t version) override {
+        insert(objectID, *static_cast<const T*>(component), version);
+    }
+
+    void insertBatchRaw(const int* objectIDs, size_t count, const void* component, uint32_t version) override {
+        const T& value = *static_cast<const T*>(component);
+
+        // Grow the sparse index once for the highest slot in the batch
+        int maxSlot = -1;
+        for (size_t i = 0; i < count; ++i) {
+            maxSlot = std::max(maxSlot, Entity::getIndex(objectIDs[i]));
+        }
+        if (maxSlot >= static_cast<int>(sparse.size())) {
+            sparse.resize(maxSlot + 1, INVALID_INDEX);
+        }
+
+        // Index every new object first, then fill the value and version arrays in bulk
+        for (size_t i = 0; i < count; ++i) {
+            int slot = Entity::getIndex(objectIDs[i]);
+            int index = sparse[slot];
+            if (index != INVALID_INDEX) {
+                components[index] = value;  // Replace the existing component in place
+                versions[index] = version;
+                continue;
+            }
+            sparse[slot] = static_cast<int>(this->objectIDs.size());
+            this->objectIDs.push_back(objectIDs[i]);
+        }
+        components.resize(this->objectIDs.size(), value);
+        versions.resize(this->objectIDs.size(), version);
+    }
+
+    /**
+     * @brief Stamp an object's component with a new change version.
+     * @param objectID The ID of the object.
+     * @param version The change version to stamp.
+     */
+    void markChanged(int objectID, uint32_t version) {
+        int index = indexOf(objectID);
+        if (index != INVALID_INDEX) {
+            versions[index] = version;
+        }
+    }
+
+    /**
+     * @brief Get the change version of an object's component.
+     * @param objectID The ID of the object.
+     * @return The version the component was last changed at, or 0 if the object has no component.
+     */
+    uint32_t getVersion(int objectID) const {
+        int index = indexOf(objectID);
+        return index != INVALID_INDEX ? versions[index] : 0;
+    }
+
+    size_t size() const override {
+        return components.size();
+    }
+
+    size_t getComponentSize() const override {
+        return sizeof(T);
+    }
+
+    size_t getSparseSize() const override {
+        return sparse.size();
+    }
+
+    void copyRaw(void* components, int* objectIDs, uint32_t* versions, int* sparse) const override {
+        std::copy(this->components.begin(), this->components.end(), static_cast<T*>(components));
+        std::copy(this->objectIDs.begin(), this->objectIDs.end(), objectIDs);
+        std::copy(this->versions.begin(), this->versions.end(), versions);
+        std::copy(this->sparse.begin(), this->sparse.end(), sparse);
+    }
+
+    void assignRaw(const void* components, const int* objectIDs, const uint32_t* versions, size_t count,
+        const int* sparse, size_t sparseSize) override {
+        const T* first = static_cast<const T*>(components);
+        this->components.assign(first, first + count);
+        this->objectIDs.assign(objectIDs, objectIDs + count);
+        this->versions.assign(versions, versions + count);
+        this->sparse.assign(sparse, sparse + sparseSize);
+    }
+
+    /**
+     * @brief Pre-allocate room for a number of components.
+     *
+     * Removed components leave their capacity behind, so once a storage has been reserved (or has
+     * grown to its peak size) adding components never calls the global allocator again.
+     *
+     * @param capacity The number of components to make room for.
+     * @param slotCapacity The number of object slots the sparse index should cover.
+     */
+    void reserve(size_t capacity, size_t slotCapacity) {
+        components.reserve(capacity);
+        objectIDs.reserve(capacity);
+        versions.reserve(capacity);
+        if (sparse.size() < slotCapacity) {
+            sparse.resize(slotCapacity, INVALID_INDEX);
+        }
+    }
+
+    /**
+     * @brief Accessor for the packed component array.
+     * @return The components, in the same order as getObjectIDs().
+     */
+    std::vector<T>& getComponents() {
+        return components;
+    }
+
+    /**
+     * @brief Accessor for the object IDs owning each packed component.
+     * @return The object IDs, in the same order as getComponents().
+     */
+    const std::vector<int>& getObjectIDs() const {
+        return objectIDs;
+    }
+
+    /**
+     * @brief Accessor for the change version of each packed component.
+     * @return The versions, in the same order as getComponents().
+     */
+    const std::vector<uint32_t>& getVersions() const {
+        return versions;
+    }
+
+private:
+    static const int INVALID_INDEX = -1;
+
+    int indexOf(int objectID) const {
+        int slot = Entity::getIndex(objectID);
+        if (objectID < 0 || slot >= static_cast<int>(sparse.size())) {
+            return INVALID_INDEX;
+        }
+
+        // The slot may have been recycled; only the exact ID owns the component
+        int index = sparse[slot];
+        if (index == INVALID_INDEX || objectIDs[index] != objectID) {
+            return INVALID_INDEX;
+        }
+        return index;
+    }
+
+    std::vector<T> components;  // Packed component values
+    std::vector<int> objectIDs; // Object ID owning each packed component
+    std::vector<uint32_t> versions; // Change version of each packed component
+    std::vector<int> sparse;    // Slot index -> index into the packed arrays
+};
+
+template <typename T>
+const int ComponentStorage<T>::INVALID_INDEX;
+
+/**
+ * @brief Create an empty storage for a property type.
+ *
+ * Code that records a property type to add later (command buffers, prefabs, snapshots) keeps a
+ * pointer to this function, so the storage can be created without knowing the type at that point.
+ *
+ * @return The new storage; the caller owns it.
+ */
+template <typename T>
+IComponentStorage* createComponentStorage() {
+    return new ComponentStorage<T>();
+}
+
+#endif // COMPONENT_STORAGE_H
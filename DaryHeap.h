@@ -0,0 +1,125 @@
+#ifndef DARY_HEAP_H
+#define DARY_HEAP_H
+
+#include <vector>
+#include <cstddef>
+#include <utility>
+
+/**
+ * @brief An implicit d-ary heap stored in a single contiguous array.
+ *
+ * Works like std::priority_queue: Compare(a, b) returns true when a should come out after b, so
+ * top() is the element that compares greatest. A wider node (4 children by default) makes the
+ * heap shallower than a binary heap, and the children of a node sit next to each other in memory,
+ * so pops with thousands of pending elements touch fewer cache lines.
+ */
+template <typename T, typename Compare, size_t Arity = 4>
+class DaryHeap {
+public:
+    static_assert(Arity >= 2, "A heap node needs at least two children");
+
+    explicit DaryHeap(Compare compare = Compare()) : compare(compare) {}
+
+    /**
+     * @brief Add an element.
+     * @param value The element to add.
+     */
+    void push(T value) {
+        elements.push_back(std::move(value));
+        siftUp(elements.size() - 1);
+    }
+
+    /**
+     * @brief Accessor for the element that comes out next.
+     * @return The top element. The heap must not be empty.
+     */
+    const T& top() const {
+        return elements.front();
+    }
+
+    /**
+     * @brief Remove and return the top element.
+     * @return The top element. The heap must not be empty.
+     */
+    T pop() {
+        T result = std::move(elements.front());
+        if (elements.size() > 1) {
+            elements.front() = std::move(elements.back());
+            elements.pop_back();
+            siftDown(0);
+        }
+        else {
+            elements.pop_back();
+        }
+        return result;
+    }
+
+    bool empty() const {
+        return elements.empty();
+    }
+
+    size_t size() const {
+        return elements.size();
+    }
+
+    /**
+     * @brief Pre-allocate room for a number of elements.
+     * @param capacity The number of elements to make room for.
+     */
+    void reserve(size_t capacity) {
+        elements.reserve(capacity);
+    }
+
+    /**
+     * @brief Remove every element while keeping the allocated memory.
+     */
+    void clear() {
+        elements.clear();
+    }
+
+private:
+    void siftUp(size_t index) {
+        T value = std::move(elements[index]);
+        while (index > 0) {
+            size_t parent = (index - 1) / Arity;
+            if (!compare(elements[parent], value)) {
+                break;
+            }
+            elements[index] = std::move(elements[parent]);
+            index = parent;
+        }
+        elements[index] = std::move(value);
+    }
+
+    void siftDown(size_t index) {
+        size_t count = elements.size();
+        T value = std::move(elements[index]);
+        while (true) {
+            size_t firstChild = index * Arity + 1;
+            if (firstChild >= count) {
+                break;
+            }
+
+            // Find the greatest of up to Arity adjacent children
+            size_t lastChild = firstChild + Arity < count ? firstChild + Arity : count;
+            size_t best = firstChild;
+            for (size_t child = firstChild + 1; child < lastChild; ++child) {
+                if (compare(elements[best], elements[child])) {
+                    best = child;
+                }
+            }
+
+            if (!compare(value, elements[best])) {
+                break;
+            }
+            elements[index] = std::move(elements[best]);
+            index = best;
+        }
+        elements[index] = std::move(value);
+    }
+
+    std::vector<T> elements; // Heap-ordered elements; the children of i are i*Arity+1 .. i*Arity+Arity
+    Compare compare;         // Ordering of the elements
+};
+
+#endif // DARY_HEAP_H
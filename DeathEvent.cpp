@@ -1,8 +1,20 @@
 #include "DeathEvent.h"
 
+static_assert(sizeof(DeathEvent) == sizeof(Event), "DeathEvent keeps its data in the event payload");
+
+// Packs the object ID into the inline payload
+static EventPayload makeObjectPayload(int objectID) {
+    EventPayload payload = {};
+    payload.object.objectID = objectID;
+    return payload;
+}
+
 DeathEvent::DeathEvent(int objectID, Timeline* timeline)
-    : Event(DEATH, 2, timeline), objectID(objectID) {}
+    : Event(DEATH, 2, timeline, makeObjectPayload(objectID)) {}
+
+DeathEvent::DeathEvent(const Event& event)
+    : Event(event) {}
 
 int DeathEvent::getObjectID() const {
-    return objectID;
+    return getPayload().object.objectID;
 }
@@ -21,15 +21,19 @@ public:
      */
     DeathEvent(int objectID, Timeline* timeline);
 
+    /**
+     * @brief Views a dispatched event as a DeathEvent.
+     *
+     * @param event An event whose type is DEATH.
+     */
+    explicit DeathEvent(const Event& event);
+
     /**
      * @brief Gets the ID of the object that triggered the death event.
      *
      * @return int The ID of the object.
      */
     int getObjectID() const;
-
-private:
-    int objectID; // ID of the object that triggered the death event.
 };
 
 #endif // DEATH_EVENT_H
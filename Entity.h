@@ -0,0 +1,48 @@
+#ifndef ENTITY_H
+#define ENTITY_H
+
+/**
+ * @brief Helpers for packing and unpacking generational object IDs.
+ *
+ * An object ID is a plain int made of a slot index (low bits) and a generation (high bits).
+ * Slots are recycled when objects are destroyed, and the generation is bumped each time a slot
+ * is freed, so an ID that outlives its object no longer matches the slot's current generation.
+ * The sign bit is never used, so every valid ID is non-negative.
+ */
+class Entity {
+public:
+    static const int INVALID_ID = -1;        // ID that never refers to a live object
+    static const int INDEX_BITS = 20;        // Bits used for the slot index (up to ~1M live objects)
+    static const int INDEX_MASK = (1 << INDEX_BITS) - 1;
+    static const int GENERATION_MASK = 0x7FF; // 11 generation bits; wraps after 2048 reuses of a slot (see PropertyManager::createObject)
+
+    /**
+     * @brief Build an object ID from a slot index and generation.
+     * @param index The slot index.
+     * @param generation The slot generation.
+     * @return The packed object ID.
+     */
+    static int makeID(int index, int generation) {
+        return ((generation & GENERATION_MASK) << INDEX_BITS) | (index & INDEX_MASK);
+    }
+
+    /**
+     * @brief Get the slot index of an object ID.
+     * @param objectID The object ID.
+     * @return The slot index.
+     */
+    static int getIndex(int objectID) {
+        return objectID & INDEX_MASK;
+    }
+
+    /**
+     * @brief Get the generation of an object ID.
+     * @param objectID The object ID.
+     * @return The generation.
+     */
+    static int getGeneration(int objectID) {
+        return (objectID >> INDEX_BITS) & GENERATION_MASK;
+    }
+};
+
+#endif // ENTITY_H
@@ -1,10 +1,16 @@
 #include "Event.h"
+#include <type_traits>
 
-Event::Event(const EventType& type, int priority, Timeline* timeline, std::unordered_map<std::string, int> data)
-    : type(type), priority(priority), data(std::move(data)) {
-    timestamp = timeline->getTime();
+static_assert(std::is_trivially_copyable<Event>::value, "Events must stay trivially copyable so they never allocate");
+
+Event::Event(const EventType& type, int priority, Timeline* timeline, const EventPayload& payload)
+    : type(type), priority(priority), payload(payload) {
+    timestamp = timeline ? timeline->getTime() : 0;
 }
 
+Event::Event(const EventType& type, int priority, int64_t timestamp, const EventPayload& payload)
+    : type(type), priority(priority), timestamp(timestamp), payload(payload) {}
+
 EventType Event::getType() const {
     return type;
 }
@@ -17,6 +23,54 @@ int64_t Event::getTimestamp() const {
     return timestamp;
 }
 
-const std::unordered_map<std::string, int>& Event::getData() const {
-    return data;
-}
\ No newline at end of file
+const EventPayload& Event::getPayload() const {
+    return payload;
+}
+
+int Event::getObjectID() const {
+    switch (type) {
+    case COLLISION:
+        return payload.collision.object1ID;
+    case SPAWN:
+    case DEATH:
+        return payload.object.objectID;
+    case INPUT:
+        return payload.input.objectID;
+    case TIMER:
+        return payload.timer.timerID;  // Lets a handler subscribe to one timer
+    default:
+        return NO_OBJECT;
+    }
+}
+
+// Packs two 32-bit values into one key
+static uint64_t packKey(int high, int low) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(high)) << 32) | static_cast<uint32_t>(low);
+}
+
+uint64_t Event::getMergeKey() const {
+    switch (type) {
+    case COLLISION: {
+        // A collision between A and B is the same collision as one between B and A
+        int first = payload.collision.object1ID;
+        int second = payload.collision.object2ID;
+        return first < second ? packKey(first, second) : packKey(second, first);
+    }
+    case INPUT:
+        return packKey(payload.input.objectID, payload.input.inputAction);
+    default:
+        return packKey(getObjectID(), 0);
+    }
+}
+
+int Event::getSource() const {
+    return source;
+}
+
+void Event::setSource(int clientId) {
+    source = clientId;
+}
+
+bool Event::isRemote() const {
+    return source != LOCAL_SOURCE;
+}
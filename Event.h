@@ -1,9 +1,8 @@
 #ifndef EVENT_H
 #define EVENT_H
 
-#include <string>
 #include <chrono>
-#include <unordered_map>
+#include <cstdint>
 #include "Timeline.h"
 
 /**
@@ -17,15 +16,62 @@ enum EventType {
     COLLISION,  // Event triggered when two objects collide.
     SPAWN,      // Event triggered when an object is spawned.
     DEATH,      // Event triggered when an object dies.
-    INPUT       // Event triggered in response to player input.
+    INPUT,      // Event triggered in response to player input.
+    TIMER,      // Event raised when a scheduled timer fires.
+    EVENT_TYPE_COUNT // Number of event types (not an event type itself).
+};
+
+/**
+ * @brief Data for events about a single object (DEATH, SPAWN).
+ */
+struct ObjectEventData {
+    int objectID; // ID of the object the event is about.
+};
+
+/**
+ * @brief Data for COLLISION events.
+ */
+struct CollisionEventData {
+    int object1ID; // ID of the first object involved in the collision.
+    int object2ID; // ID of the second object involved in the collision.
+};
+
+/**
+ * @brief Data for INPUT events.
+ */
+struct InputEventData {
+    int objectID;    // ID of the object receiving the input.
+    int inputAction; // The InputAction performed.
+};
+
+/**
+ * @brief Data for TIMER events.
+ */
+struct TimerEventData {
+    int timerID; // ID chosen by the code that scheduled the timer.
+};
+
+/**
+ * @brief Fixed-size data carried inline by every event.
+ *
+ * Each event type reads and writes only the member that belongs to it. Keeping the data inline
+ * makes every event the same small, trivially copyable size, so building, copying and queueing an
+ * event never allocates.
+ */
+union EventPayload {
+    ObjectEventData object;       // DEATH and SPAWN events
+    CollisionEventData collision; // COLLISION events
+    InputEventData input;         // INPUT events
+    TimerEventData timer;         // TIMER events
 };
 
 /**
  * @brief Base class for all game events.
  *
  * The Event class serves as a foundational structure for all types of events within the game.
- * It includes basic properties, such as the event type, priority, timestamp, and additional data.
- * Derived event types inherit from this class and may add more specific attributes or methods.
+ * It includes basic properties, such as the event type, priority, timestamp, and an inline payload.
+ * Derived event types inherit from this class and add typed accessors for their part of the
+ * payload; they add no data members of their own, so every event stays trivially copyable.
  */
 class Event {
 public:
@@ -34,17 +80,20 @@ public:
      *
      * @param type The type of the event (e.g., COLLISION, DEATH).
      * @param priority The priority level of the event (used to determine event handling order).
-     * @param timeline Pointer to the game's timeline (for generating the event timestamp).
-     * @param data Additional data related to the event, represented as key-value pairs (optional).
+     * @param timeline Pointer to the game's timeline (for generating the event timestamp), or nullptr to stamp the event with 0.
+     * @param payload Data related to the event (optional).
      */
-    Event(const EventType& type, int priority, Timeline* timeline, std::unordered_map<std::string, int> data = {});
+    Event(const EventType& type, int priority, Timeline* timeline, const EventPayload& payload = EventPayload());
 
     /**
-     * @brief Virtual destructor for the Event class.
+     * @brief Constructs an Event with a known timestamp, such as one read back from a journal.
      *
-     * Allows for proper cleanup of derived event classes.
+     * @param type The type of the event.
+     * @param priority The priority level of the event.
+     * @param timestamp The timestamp of the event in milliseconds.
+     * @param payload Data related to the event.
      */
-    virtual ~Event() = default;
+    Event(const EventType& type, int priority, int64_t timestamp, const EventPayload& payload);
 
     /**
      * @brief Gets the type of the event.
@@ -70,17 +119,63 @@ public:
     int64_t getTimestamp() const;
 
     /**
-     * @brief Gets additional data associated with the event.
+     * @brief Gets the data associated with the event.
+     *
+     * @return const EventPayload& A reference to the payload.
+     */
+    const EventPayload& getPayload() const;
+
+    /**
+     * @brief Gets the ID of the object the event is about.
+     *
+     * Used to route the event to handlers subscribed for that object. For COLLISION events this
+     * is the first object involved in the collision, and for TIMER events the timer ID.
+     *
+     * @return int The object ID, or NO_OBJECT if the event type carries none.
+     */
+    int getObjectID() const;
+
+    /**
+     * @brief Gets the key that identifies duplicates of this event.
+     *
+     * Two queued events of the same type with the same merge key describe the same thing, so a
+     * coalescing queue keeps only one of them: DEATH and SPAWN events merge per object, INPUT
+     * events per object and action, and COLLISION events per pair of objects in either order.
+     *
+     * @return uint64_t The merge key, unique within the event's type.
+     */
+    uint64_t getMergeKey() const;
+
+    /**
+     * @brief Gets the client the event was raised on.
+     *
+     * @return int The ID of the client that raised the event, or LOCAL_SOURCE if it was raised in this process.
+     */
+    int getSource() const;
+
+    /**
+     * @brief Marks the event as raised by another client; used when events arrive over the network.
      *
-     * @return const std::unordered_map<std::string, int>& A reference to the data map.
+     * @param clientId The ID of the client that raised the event.
      */
-    const std::unordered_map<std::string, int>& getData() const;
+    void setSource(int clientId);
+
+    /**
+     * @brief Checks whether the event was raised by another client.
+     *
+     * @return True if the event came from another client, false if it was raised locally.
+     */
+    bool isRemote() const;
+
+    static const int NO_OBJECT = -1;    // Object ID of events that are not about an object
+    static const int LOCAL_SOURCE = -1; // Source of events raised in this process
 
 private:
     EventType type; // The type of the event (e.g., COLLISION, DEATH).
     int priority;   // Priority level of the event.
     int64_t timestamp; // Timestamp of the event in milliseconds.
-    std::unordered_map<std::string, int> data; // Additional data associated with the event.
+    EventPayload payload; // Data associated with the event.
+    int source = LOCAL_SOURCE; // Client that raised the event.
 };
 
 #endif // EVENT_H
@@ -0,0 +1,15 @@
+#include "EventChannel.h"
+#include <iostream>
+#include <cstdlib>
+
+// Hand out the next channel ID
+size_t IEventChannel::nextChannelID() {
+    static std::atomic<size_t> nextID{ 0 };
+    size_t id = nextID.fetch_add(1, std::memory_order_relaxed);
+    if (id >= MAX_CHANNELS) {
+        // The channel table is fixed so other threads can read it without a lock; raise MAX_CHANNELS instead
+        std::cerr << "Too many typed event types (the limit is " << MAX_CHANNELS << ")" << std::endl;
+        std::abort();
+    }
+    return id;
+}
@@ -0,0 +1,280 @@
+#ifndef EVENT_CHANNEL_H
+#define EVENT_CHANNEL_H
+
+#include <vector>
+#include <functional>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <type_traits>
+#include <cstddef>
+#include <cstdint>
+#include "MpscRingBuffer.h"
+
+/**
+ * @brief Type-erased interface for a single typed event channel.
+ *
+ * The EventManager keeps one channel per event struct type. Dispatching and unsubscribing do not
+ * need to know the concrete event type, so they go through this interface.
+ */
+class IEventChannel {
+public:
+    static const size_t MAX_CHANNELS = 64; // Typed event types one program can use; sizes the EventManager's channel table
+
+    virtual ~IEventChannel() = default;
+
+    /**
+     * @brief Invoke the registered handlers for every queued event, oldest first.
+     *
+     * Events raised by the handlers into this channel are dispatched in the same call.
+     *
+     * @return The number of events dispatched.
+     */
+    virtual size_t dispatch() = 0;
+
+    /**
+     * @brief Remove a handler. Safe to call from inside a handler during dispatch.
+     * @param id The ID of the handler.
+     */
+    virtual void unsubscribe(uint32_t id) = 0;
+
+    /**
+     * @brief Get the number of events waiting on the dispatching thread.
+     * @return The number of queued events, not counting events raised on other threads since the last dispatch.
+     */
+    virtual size_t size() const = 0;
+
+protected:
+    /**
+     * @brief Hand out the next channel ID; each event type asks once.
+     * @return A small ID below MAX_CHANNELS, unique per event type for the whole program.
+     */
+    static size_t nextChannelID();
+};
+
+/**
+ * @brief Queue and handlers for the events of one struct type.
+ *
+ * Events are plain structs of type T, kept by value in a contiguous array and passed to handlers
+ * as const T&, so handlers need no cast and no EventType entry is needed to add an event type.
+ * Each type gets its channel ID from a static counter the first time it is used.
+ *
+ * raise() may be called from any thread: events raised on the dispatching thread go straight
+ * into the array, and events raised on other threads go through a lock-free ring and are picked
+ * up at the next dispatch. Everything else must happen on the dispatching thread.
+ *
+ * The class is final so typed calls through an EventChannel<T> are resolved without virtual dispatch.
+ */
+template <typename T>
+class EventChannel final : public IEventChannel {
+public:
+    static_assert(std::is_trivially_copyable<T>::value, "Typed events must be trivially copyable");
+    static_assert(std::is_default_constructible<T>::value, "Typed events must be default-constructible");
+
+    /**
+     * @brief Get the channel ID of the event type.
+     * @return The same ID in every EventManager, so it can index a plain array of channels.
+     */
+    static size_t getID() {
+        static const size_t id = nextChannelID();
+        return id;
+    }
+
+    /**
+     * @brief Construct an empty channel.
+     * @param consumerThread The thread that dispatches the channel; events raised on any other thread go through the ring.
+     */
+    explicit EventChannel(std::thread::id consumerThread) : incomingEvents(INCOMING_CAPACITY), consumerThread(consumerThread) {}
+
+    /**
+     * @brief Queue an event for the next dispatch. Safe to call from any thread.
+     *
+     * If the ring stays full for RING_FULL_WAIT_MS, the event is dropped and counted instead of
+     * waiting on a dispatch that may never come, for example when the raising thread is the one
+     * that will dispatch but has not dispatched yet.
+     *
+     * @param event The event; it is copied.
+     * @return True if the event was queued, false if it was dropped.
+     */
+    bool raise(const T& event) {
+        if (consumerThread.load(std::memory_order_relaxed) == std::this_thread::get_id()) {
+            queuedEvents.push_back(event);
+            return true;
+        }
+        if (incomingEvents.tryPush(event)) {
+            return true;
+        }
+
+        // The ring is full: give the dispatching thread a while to empty it
+        int64_t waitMs = RING_FULL_WAIT_MS;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(waitMs);
+        while (std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::yield();
+            if (incomingEvents.tryPush(event)) {
+                return true;
+            }
+        }
+        droppedEvents.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    /**
+     * @brief Register a handler. Handlers added during dispatch see the events of the next dispatch.
+     * @param id The ID the handler is removed by.
+     * @param handler The handler.
+     */
+    void subscribe(uint32_t id, std::function<void(const T&)> handler) {
+        HandlerEntry entry = { id, std::move(handler), true };
+        if (dispatchDepth > 0) {
+            pendingHandlers.push_back(std::move(entry));
+        }
+        else {
+            handlers.push_back(std::move(entry));
+        }
+    }
+
+    void unsubscribe(uint32_t id) override {
+        for (HandlerEntry& entry : pendingHandlers) {
+            if (entry.id == id) {
+                entry.active = false;
+                return;
+            }
+        }
+        for (size_t i = 0; i < handlers.size(); ++i) {
+            if (handlers[i].id != id) {
+                continue;
+            }
+            if (dispatchDepth > 0) {
+                handlers[i].active = false;  // The handler may be running right now
+                hasRemovals = true;
+            }
+            else {
+                handlers.erase(handlers.begin() + i);
+            }
+            return;
+        }
+    }
+
+    size_t dispatch() override {
+        return consume([this](const T& event) {
+            for (const HandlerEntry& entry : handlers) {
+                if (entry.active) {
+                    entry.handler(event);
+                }
+            }
+        });
+    }
+
+    /**
+     * @brief Pass every queued event to one handler instead of the registered ones.
+     *
+     * The handler is a template parameter, so the call is inlined into the loop over the events.
+     * Use it where one system owns the events of a type, for example to resolve every queued
+     * spawn in one pass. The events are consumed, so registered handlers do not see them.
+     *
+     * @param handler Called with each event, oldest first.
+     * @return The number of events passed to the handler.
+     */
+    template <typename Handler>
+    size_t drain(Handler&& handler) {
+        return consume(handler);
+    }
+
+    size_t size() const override {
+        return queuedEvents.size();
+    }
+
+    /**
+     * @brief Get the number of events dropped because the ring stayed full. Safe to call from any thread.
+     * @return The number of dropped events since the channel was created.
+     */
+    uint64_t getDroppedCount() const {
+        return droppedEvents.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the number of registered handlers.
+     * @return The number of handlers, including changes still pending from a dispatch.
+     */
+    size_t getHandlerCount() const {
+        size_t count = 0;
+        for (const HandlerEntry& entry : handlers) {
+            count += entry.active ? 1 : 0;
+        }
+        for (const HandlerEntry& entry : pendingHandlers) {
+            count += entry.active ? 1 : 0;
+        }
+        return count;
+    }
+
+private:
+    static const size_t INCOMING_CAPACITY = 1024; // Events other threads can raise between dispatches
+    static const int RING_FULL_WAIT_MS = 100;     // Longest raise() waits for room before dropping the event
+
+    /**
+     * @brief A registered handler.
+     */
+    struct HandlerEntry {
+        uint32_t id;                           // ID shared with the handler's Subscription
+        std::function<void(const T&)> handler; // The handler itself
+        bool active;                           // False once unsubscribed during a dispatch
+    };
+
+    // Collect events raised on other threads, then pass every queued event to a handler
+    template <typename Handler>
+    size_t consume(Handler&& handler) {
+        if (dispatchDepth > 0) {
+            return 0;  // Dispatching again from a handler; the running loop picks up the new events
+        }
+
+        consumerThread.store(std::this_thread::get_id(), std::memory_order_relaxed);
+        T incomingEvent;
+        while (incomingEvents.tryPop(incomingEvent)) {
+            queuedEvents.push_back(incomingEvent);
+        }
+
+        // Swap the queue out so handlers can raise into it; those events go round again
+        size_t dispatched = 0;
+        ++dispatchDepth;
+        while (!queuedEvents.empty()) {
+            dispatchingEvents.swap(queuedEvents);
+            for (const T& event : dispatchingEvents) {
+                handler(event);
+            }
+            dispatched += dispatchingEvents.size();
+            dispatchingEvents.clear();
+        }
+        --dispatchDepth;
+
+        applyPendingHandlerChanges();
+        return dispatched;
+    }
+
+    // Apply the handler additions and removals deferred during dispatch
+    void applyPendingHandlerChanges() {
+        if (hasRemovals) {
+            handlers.erase(std::remove_if(handlers.begin(), handlers.end(),
+                [](const HandlerEntry& entry) { return !entry.active; }), handlers.end());
+            hasRemovals = false;
+        }
+        for (HandlerEntry& entry : pendingHandlers) {
+            if (entry.active) {
+                handlers.push_back(std::move(entry));
+            }
+        }
+        pendingHandlers.clear();
+    }
+
+    std::vector<T> queuedEvents;               // Events waiting for the next dispatch, oldest first
+    std::vector<T> dispatchingEvents;          // Events being dispatched (kept to reuse its memory)
+    MpscRingBuffer<T> incomingEvents;          // Events raised on other threads
+    std::atomic<std::thread::id> consumerThread; // Thread that last dispatched the channel
+    std::atomic<uint64_t> droppedEvents{ 0 };  // Events dropped because the ring stayed full
+    std::vector<HandlerEntry> handlers;        // Registered handlers, in subscription order
+    std::vector<HandlerEntry> pendingHandlers; // Handlers subscribed during dispatch
+    bool hasRemovals = false;                  // Whether a handler was unsubscribed during dispatch
+    int dispatchDepth = 0;                     // 1 while the channel is being dispatched
+};
+
+#endif // EVENT_CHANNEL_H
@@ -0,0 +1,207 @@
+#include "EventJournal.h"
+#include <iostream>
+#include <type_traits>
+#include <cstring>
+
+static_assert(std::is_trivially_copyable<EventJournalRecord>::value, "Journal records are written as raw bytes");
+static_assert(sizeof(EventJournalRecord) == 32, "Journal records must keep a fixed, padding-free layout");
+
+namespace {
+
+/**
+ * @brief Fixed header at the start of every journal file.
+ */
+struct JournalHeader {
+    uint32_t magic;         // EventJournal::MAGIC
+    uint32_t formatVersion; // EventJournal::FORMAT_VERSION
+    uint32_t recordSize;    // Size of one record
+    uint32_t reserved;      // Keeps the records 8-byte aligned
+};
+
+}
+
+// Flush and close the journal
+EventJournal::~EventJournal() {
+    close();
+}
+
+// Create a journal file and write its header
+bool EventJournal::open(const std::string& path) {
+    close();
+
+    file.open(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        std::cerr << "Failed to open event journal for writing: " << path << std::endl;
+        return false;
+    }
+
+    JournalHeader header = { MAGIC, FORMAT_VERSION, static_cast<uint32_t>(sizeof(EventJournalRecord)), 0 };
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    buffer.reserve(BUFFER_RECORDS);
+    recordCount = 0;
+    return true;
+}
+
+// Write the buffered records and close the file
+void EventJournal::close() {
+    if (file.is_open()) {
+        flush();
+        file.close();
+    }
+}
+
+// Check whether the journal is open
+bool EventJournal::isOpen() const {
+    return file.is_open();
+}
+
+// Append an event to the journal
+void EventJournal::record(const Event& event) {
+    buffer.push_back(toRecord(event));
+    ++recordCount;
+
+    if (buffer.size() >= BUFFER_RECORDS) {
+        flush();
+    }
+}
+
+// Append a frame marker to the journal
+void EventJournal::recordFrame(int64_t currentTime) {
+    EventJournalRecord record;
+    std::memset(&record, 0, sizeof(record));
+    record.type = FRAME_RECORD_TYPE;
+    record.timestamp = currentTime;
+    buffer.push_back(record);
+
+    if (buffer.size() >= BUFFER_RECORDS) {
+        flush();
+    }
+}
+
+// Write the buffered records to the file
+void EventJournal::flush() {
+    if (buffer.empty() || !file.is_open()) {
+        return;
+    }
+    file.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size() * sizeof(EventJournalRecord)));
+    if (!file) {
+        std::cerr << "Failed to write event journal; recording stopped" << std::endl;
+        file.close();
+    }
+    buffer.clear();
+}
+
+// Get the number of recorded events
+uint64_t EventJournal::getRecordCount() const {
+    return recordCount;
+}
+
+// Convert an event to its stored form
+EventJournalRecord EventJournal::toRecord(const Event& event) {
+    EventJournalRecord record;
+    record.type = event.getType();
+    record.priority = event.getPriority();
+    record.timestamp = event.getTimestamp();
+    record.payload = event.getPayload();
+    record.source = event.getSource();
+    record.reserved = 0;
+    return record;
+}
+
+// Convert a stored record back to an event
+Event EventJournal::fromRecord(const EventJournalRecord& record) {
+    Event event(static_cast<EventType>(record.type), record.priority, record.timestamp, record.payload);
+    event.setSource(record.source);
+    return event;
+}
+
+// Open a journal file and check its header
+bool EventJournalReader::open(const std::string& path) {
+    file.close();
+    file.clear();
+    buffer.clear();
+    position = 0;
+
+    file.open(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Failed to open event journal: " << path << std::endl;
+        return false;
+    }
+
+    JournalHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) || header.magic != EventJournal::MAGIC
+        || header.formatVersion != EventJournal::FORMAT_VERSION || header.recordSize != sizeof(EventJournalRecord)) {
+        std::cerr << "Incompatible event journal: " << path << std::endl;
+        file.close();
+        return false;
+    }
+
+    buffer.reserve(BUFFER_RECORDS);
+    return true;
+}
+
+// Read the next event, skipping frame markers
+bool EventJournalReader::next(Event& event) {
+    while (const EventJournalRecord* record = peek()) {
+        ++position;
+        if (record->type != EventJournal::FRAME_RECORD_TYPE) {
+            event = EventJournal::fromRecord(*record);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Move to the start of the next frame
+bool EventJournalReader::nextFrame(int64_t& currentTime) {
+    while (const EventJournalRecord* record = peek()) {
+        ++position;
+        if (record->type == EventJournal::FRAME_RECORD_TYPE) {
+            currentTime = record->timestamp;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Read the next event of the current frame
+bool EventJournalReader::nextInFrame(Event& event) {
+    const EventJournalRecord* record = peek();
+    if (!record || record->type == EventJournal::FRAME_RECORD_TYPE) {
+        return false;
+    }
+    ++position;
+    event = EventJournal::fromRecord(*record);
+    return true;
+}
+
+// Return the next record without consuming it
+const EventJournalRecord* EventJournalReader::peek() {
+    if (position == buffer.size()) {
+        if (!file.is_open()) {
+            return nullptr;
+        }
+
+        // Refill the buffer with the next block of records; a torn last record is dropped
+        buffer.resize(BUFFER_RECORDS);
+        file.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(BUFFER_RECORDS * sizeof(EventJournalRecord)));
+        buffer.resize(static_cast<size_t>(file.gcount()) / sizeof(EventJournalRecord));
+        position = 0;
+        if (buffer.size() < BUFFER_RECORDS) {
+            file.close();
+        }
+        if (buffer.empty()) {
+            return nullptr;
+        }
+    }
+
+    const EventJournalRecord& record = buffer[position];
+    if (record.type != EventJournal::FRAME_RECORD_TYPE && (record.type < 0 || record.type >= EVENT_TYPE_COUNT)) {
+        std::cerr << "Corrupt event journal record; replay stopped" << std::endl;
+        file.close();
+        buffer.clear();
+        position = 0;
+        return nullptr;
+    }
+    return &record;
+}
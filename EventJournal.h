@@ -0,0 +1,165 @@
+#ifndef EVENT_JOURNAL_H
+#define EVENT_JOURNAL_H
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdint>
+#include <climits>
+#include "Event.h"
+
+/**
+ * @brief One event, or one frame marker, as stored in a journal file.
+ */
+struct EventJournalRecord {
+    int32_t type;         // EventType of the event, or EventJournal::FRAME_RECORD_TYPE for a frame marker
+    int32_t priority;     // Priority of the event
+    int64_t timestamp;    // Timestamp of the event, on the timeline that stamped it (a frame marker's dispatch time)
+    EventPayload payload; // The event's inline payload
+    int32_t source;       // Client that raised the event (Event::LOCAL_SOURCE for this process)
+    int32_t reserved;     // Keeps the record a multiple of 8 bytes
+};
+
+/**
+ * @brief Appends events to a binary journal file.
+ *
+ * The file is a small header followed by one fixed-size EventJournalRecord per event, in the order
+ * the events were recorded. A frame marker record starts the events of each dispatch and holds the
+ * time the dispatch ran at, so a replay can step the game between the same frames as the session. Records are collected in memory and written in large blocks, so
+ * recording an event is a copy into a buffer and costs no system call. The records are written as
+ * they are laid out in memory, so a journal can only be read by a build with the same event layout
+ * on a machine with the same byte order; the header lets a reader reject anything else.
+ */
+class EventJournal {
+public:
+    static const uint32_t MAGIC = 0x4C4A5645;   // "EVJL" in file byte order on little-endian machines
+    static const uint32_t FORMAT_VERSION = 4; // Bump whenever the record layout or the event payload changes
+    static const int32_t FRAME_RECORD_TYPE = -1;   // Record type of a frame marker
+    static const int64_t UNTIMED_FRAME = INT64_MIN; // Frame time of a dispatch that was given no current time
+
+    EventJournal() = default;
+
+    /**
+     * @brief Flushes and closes the journal.
+     */
+    ~EventJournal();
+
+    EventJournal(const EventJournal&) = delete;
+    EventJournal& operator=(const EventJournal&) = delete;
+
+    /**
+     * @brief Create (or truncate) a journal file and write its header.
+     * @param path The file to write.
+     * @return True if the file is open for recording, false otherwise.
+     */
+    bool open(const std::string& path);
+
+    /**
+     * @brief Write any buffered records and close the file.
+     */
+    void close();
+
+    /**
+     * @brief Check whether the journal is open for recording.
+     * @return True if events are being recorded.
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief Append an event to the journal.
+     * @param event The event to record.
+     */
+    void record(const Event& event);
+
+    /**
+     * @brief Append a frame marker; the events recorded after it belong to that frame.
+     * @param currentTime The time the frame's dispatch ran at, or UNTIMED_FRAME.
+     */
+    void recordFrame(int64_t currentTime);
+
+    /**
+     * @brief Write the buffered records to the file.
+     */
+    void flush();
+
+    /**
+     * @brief Get the number of events recorded since the journal was opened.
+     * @return The number of recorded events, not counting frame markers.
+     */
+    uint64_t getRecordCount() const;
+
+    /**
+     * @brief Convert an event to its stored form.
+     * @param event The event.
+     * @return The record holding the event.
+     */
+    static EventJournalRecord toRecord(const Event& event);
+
+    /**
+     * @brief Convert a stored record back to an event.
+     * @param record The record; its type must be a valid EventType.
+     * @return The event, with its recorded timestamp and source.
+     */
+    static Event fromRecord(const EventJournalRecord& record);
+
+private:
+    static const size_t BUFFER_RECORDS = 4096; // Records collected before each write
+
+    std::ofstream file;                       // The journal file
+    std::vector<EventJournalRecord> buffer;   // Records not written yet
+    uint64_t recordCount = 0;                 // Records appended since open()
+};
+
+/**
+ * @brief Reads the events of a journal file back, in the order they were recorded.
+ *
+ * Records are read in large blocks and turned back into events without any per-event allocation,
+ * so a journal can be replayed as fast as the handlers consume it.
+ */
+class EventJournalReader {
+public:
+    EventJournalReader() = default;
+
+    EventJournalReader(const EventJournalReader&) = delete;
+    EventJournalReader& operator=(const EventJournalReader&) = delete;
+
+    /**
+     * @brief Open a journal file and check its header.
+     * @param path The file to read.
+     * @return True if the file is a journal this build can read, false otherwise.
+     */
+    bool open(const std::string& path);
+
+    /**
+     * @brief Read the next event, skipping frame markers.
+     * @param event Receives the event, with its recorded timestamp.
+     * @return True if an event was read, false at the end of the journal.
+     */
+    bool next(Event& event);
+
+    /**
+     * @brief Move to the start of the next frame, skipping any events left in the current one.
+     * @param currentTime Receives the time the frame was dispatched at (EventJournal::UNTIMED_FRAME if unknown).
+     * @return True if a frame marker was read, false at the end of the journal.
+     */
+    bool nextFrame(int64_t& currentTime);
+
+    /**
+     * @brief Read the next event of the current frame.
+     * @param event Receives the event, with its recorded timestamp.
+     * @return True if an event was read, false at the next frame marker (left unread) or the end of the journal.
+     */
+    bool nextInFrame(Event& event);
+
+private:
+    static const size_t BUFFER_RECORDS = 4096; // Records read from the file at a time
+
+    // Returns the next record without consuming it, or nullptr at the end of the journal
+    const EventJournalRecord* peek();
+
+    std::ifstream file;                     // The journal file
+    std::vector<EventJournalRecord> buffer; // Records read but not returned yet
+    size_t position = 0;                    // Index of the next record in the buffer
+};
+
+#endif // EVENT_JOURNAL_H
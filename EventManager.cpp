@@ -1,30 +1,485 @@
 #include "EventManager.h"
 #include <iostream> // For debug output
+#include <algorithm>
 
 // Method to register a handler for a specific event type
-void EventManager::registerHandler(EventType eventType, std::function<void(std::shared_ptr<Event>)> handler) {
-    handlers[eventType].push_back(handler);
+Subscription EventManager::subscribe(EventType eventType, std::function<void(const Event&)> handler) {
+    return subscribe(eventType, Event::NO_OBJECT, std::move(handler));
+}
+
+// Method to register a handler for the events of a type that are about one object
+Subscription EventManager::subscribe(EventType eventType, int objectID, std::function<void(const Event&)> handler) {
+    return addHandler(eventType, objectID, std::move(handler));
+}
+
+// Method to register a handler for events of a type raised by other clients
+Subscription EventManager::subscribeRemote(EventType eventType, std::function<void(const Event&)> handler) {
+    return addHandler(eventType, REMOTE_EVENTS, std::move(handler));
+}
+
+// Method to register a thread-safe handler that may run on a worker thread
+Subscription EventManager::subscribeConcurrent(EventType eventType, std::function<void(const Event&)> handler) {
+    return addHandler(eventType, CONCURRENT_EVENTS, std::move(handler));
+}
+
+// Method to set the worker pool that runs the concurrent handlers
+void EventManager::setWorkerPool(WorkerPool* workerPool) {
+    this->workerPool = workerPool;
+}
+
+// Method to add a handler to the list for a key
+Subscription EventManager::addHandler(EventType eventType, int key, std::function<void(const Event&)> handler) {
+    uint32_t id = nextHandlerID++;
+    HandlerEntry entry = { id, std::move(handler), true };
+
+    // Growing a handler list (or the object index) while it is being walked would move the running handler
+    if (dispatchDepth > 0) {
+        PendingHandler pending = { eventType, key, std::move(entry) };
+        pendingHandlers.push_back(std::move(pending));
+    }
+    else {
+        getOrCreateHandlers(eventType, key).push_back(std::move(entry));
+    }
+    return Subscription(this, eventType, key, id);
+}
+
+// Method to count the handlers for an event type
+size_t EventManager::getHandlerCount(EventType eventType, int objectID) const {
+    size_t count = 0;
+    const std::vector<HandlerEntry>* entries = findHandlers(eventType, objectID);
+    if (entries) {
+        for (const HandlerEntry& entry : *entries) {
+            count += entry.active ? 1 : 0;
+        }
+    }
+    for (const PendingHandler& pending : pendingHandlers) {
+        count += pending.eventType == eventType && pending.objectID == objectID && pending.entry.active ? 1 : 0;
+    }
+    return count;
+}
+
+// Method to find the handler list for an event type and key
+std::vector<EventManager::HandlerEntry>* EventManager::findHandlers(EventType eventType, int key) {
+    const EventManager* constThis = this;
+    return const_cast<std::vector<HandlerEntry>*>(constThis->findHandlers(eventType, key));
+}
+
+// Method to find the handler list for an event type and key
+const std::vector<EventManager::HandlerEntry>* EventManager::findHandlers(EventType eventType, int key) const {
+    if (key == Event::NO_OBJECT) {
+        return &handlers[eventType];
+    }
+    if (key == REMOTE_EVENTS) {
+        return &remoteHandlers[eventType];
+    }
+    if (key == CONCURRENT_EVENTS) {
+        return &concurrentHandlers[eventType];
+    }
+    auto it = objectHandlers[eventType].find(key);
+    return it != objectHandlers[eventType].end() ? &it->second : nullptr;
+}
+
+// Method to get the handler list for an event type and key, adding an object's list if needed
+std::vector<EventManager::HandlerEntry>& EventManager::getOrCreateHandlers(EventType eventType, int key) {
+    if (key == Event::NO_OBJECT) {
+        return handlers[eventType];
+    }
+    if (key == REMOTE_EVENTS) {
+        return remoteHandlers[eventType];
+    }
+    if (key == CONCURRENT_EVENTS) {
+        return concurrentHandlers[eventType];
+    }
+    return objectHandlers[eventType][key];
+}
+
+// Method to drop an object's handler list once its last handler is gone
+void EventManager::releaseEmptyHandlers(EventType eventType, int key) {
+    if (key == Event::NO_OBJECT || key == REMOTE_EVENTS || key == CONCURRENT_EVENTS) {
+        return;  // The per-type lists always exist
+    }
+    auto it = objectHandlers[eventType].find(key);
+    if (it != objectHandlers[eventType].end() && it->second.empty()) {
+        objectHandlers[eventType].erase(it);
+    }
+}
+
+// Method to remove a handler
+void EventManager::unsubscribe(EventType eventType, int objectID, uint32_t id) {
+    if (eventType == TYPED_EVENTS) {
+        channels[objectID].load(std::memory_order_acquire)->unsubscribe(id);  // Typed handlers are keyed by channel ID
+        return;
+    }
+
+    for (PendingHandler& pending : pendingHandlers) {
+        if (pending.entry.id == id) {
+            pending.entry.active = false;
+            return;
+        }
+    }
+
+    std::vector<HandlerEntry>* entries = findHandlers(eventType, objectID);
+    if (!entries) {
+        return;
+    }
+    for (size_t i = 0; i < entries->size(); ++i) {
+        if ((*entries)[i].id != id) {
+            continue;
+        }
+        if (dispatchDepth > 0) {
+            // The handler may be running right now; drop it once dispatch finishes
+            (*entries)[i].active = false;
+            pendingRemovals.push_back(std::make_pair(eventType, objectID));
+        }
+        else {
+            entries->erase(entries->begin() + i);
+            releaseEmptyHandlers(eventType, objectID);
+        }
+        return;
+    }
+}
+
+// Method to apply handler changes deferred during dispatch
+void EventManager::applyPendingHandlerChanges() {
+    for (const auto& removal : pendingRemovals) {
+        std::vector<HandlerEntry>* entries = findHandlers(removal.first, removal.second);
+        if (!entries) {
+            continue;  // Already emptied by an earlier removal from the same list
+        }
+        entries->erase(std::remove_if(entries->begin(), entries->end(),
+            [](const HandlerEntry& entry) { return !entry.active; }), entries->end());
+        releaseEmptyHandlers(removal.first, removal.second);
+    }
+    pendingRemovals.clear();
+
+    for (PendingHandler& pending : pendingHandlers) {
+        if (pending.entry.active) {
+            getOrCreateHandlers(pending.eventType, pending.objectID).push_back(std::move(pending.entry));
+        }
+    }
+    pendingHandlers.clear();
+}
+
+// Method to invoke the active handlers in a list
+void EventManager::invokeHandlers(const std::vector<HandlerEntry>& entries, const Event& event, EventStats* stats) {
+    for (const HandlerEntry& entry : entries) {
+        if (!entry.active) {
+            continue;
+        }
+        if (stats) {
+            int64_t start = EventQueue::now();
+            entry.handler(event);
+            stats->recordHandler(event.getType(), static_cast<uint64_t>(EventQueue::now() - start));
+        }
+        else {
+            entry.handler(event);
+        }
+    }
 }
 
 // Method to raise an event
-void EventManager::raiseEvent(std::shared_ptr<Event> event) {
+void EventManager::raiseEvent(const Event& event) {
+    if (replaying.load(std::memory_order_relaxed)) {
+        return;  // The journal being replayed already holds this event
+    }
+    if (statsEnabled.load(std::memory_order_relaxed)) {
+        stats.recordRaised(event.getType());
+    }
     eventQueue.pushEvent(event);
 }
 
+// Method to schedule an event for dispatch after a delay
+void EventManager::scheduleEvent(const Event& event, int64_t delay) {
+    if (replaying.load(std::memory_order_relaxed)) {
+        return;
+    }
+    if (statsEnabled.load(std::memory_order_relaxed)) {
+        stats.recordRaised(event.getType());
+    }
+    eventQueue.scheduleEvent(event, event.getTimestamp() + delay);
+}
+
+// Method to turn coalescing on or off for an event type
+void EventManager::setCoalescing(EventType eventType, bool enabled) {
+    eventQueue.setCoalescing(eventType, enabled);
+}
+
+// Method to get the number of merged events
+uint64_t EventManager::getMergedEventCount() const {
+    return eventQueue.getMergedCount();
+}
+
+// Method to turn replication on or off for an event type
+void EventManager::setReplicated(EventType eventType, bool replicated) {
+    replicatedTypes[eventType] = replicated;
+}
+
+// Method to check whether an event type is replicated
+bool EventManager::isReplicated(EventType eventType) const {
+    return replicatedTypes[eventType];
+}
+
+// Method to hand over the replicated events dispatched since the last call
+void EventManager::takeReplicatedEvents(std::vector<Event>& events) {
+    // Swapping keeps both buffers' memory, so a steady stream of events does not allocate
+    events.clear();
+    events.swap(replicatedEvents);
+}
+
+// Method to limit the work of a single dispatch
+void EventManager::setDispatchBudget(size_t maxEvents, int64_t maxMicroseconds) {
+    maxDispatchEvents = maxEvents;
+    maxDispatchTime = std::chrono::microseconds(maxMicroseconds > 0 ? maxMicroseconds : 0);
+}
+
+// Method to get the backlog left by the last dispatch
+size_t EventManager::getBacklog() const {
+    return backlog;
+}
+
+// Method to get the peak backlog
+size_t EventManager::getPeakBacklog() const {
+    return peakBacklog;
+}
+
+// Method to get the number of events dispatched by the last dispatch
+size_t EventManager::getLastDispatchCount() const {
+    return lastDispatchCount;
+}
+
+// Method to get the number of budget-limited dispatches
+uint64_t EventManager::getBudgetExceededCount() const {
+    return budgetExceededCount;
+}
+
+// Method to turn event instrumentation on or off
+void EventManager::setStatsEnabled(bool enabled) {
+    statsEnabled.store(enabled, std::memory_order_relaxed);
+    eventQueue.setTiming(enabled);
+}
+
+// Method to check whether event instrumentation is on
+bool EventManager::isStatsEnabled() const {
+    return statsEnabled.load(std::memory_order_relaxed);
+}
+
+// Method to get the recorded statistics
+EventStats& EventManager::getStats() {
+    return stats;
+}
+
+// Method to record dispatched events to a journal
+void EventManager::setJournal(EventJournal* journal) {
+    this->journal = journal;
+}
+
+// Method to replay a journal through the registered handlers
+uint64_t EventManager::replay(EventJournalReader& reader) {
+    replaying.store(true, std::memory_order_relaxed);
+
+    uint64_t replayed = 0;
+    Event event(INPUT, 0, nullptr);
+    while (reader.next(event)) {
+        replayEvent(event);
+        ++replayed;
+    }
+
+    replaying.store(false, std::memory_order_relaxed);
+    return replayed;
+}
+
+// Method to replay the next recorded frame through the registered handlers
+bool EventManager::replayFrame(EventJournalReader& reader, int64_t& currentTime) {
+    if (!reader.nextFrame(currentTime)) {
+        endReplay();
+        return false;
+    }
+
+    // Stays set between frames too, while the game's update raises events the journal already holds
+    replaying.store(true, std::memory_order_relaxed);
+
+    Event event(INPUT, 0, nullptr);
+    while (reader.nextInFrame(event)) {
+        replayEvent(event);
+    }
+    return true;
+}
+
+// Method to stop a frame-by-frame replay
+void EventManager::endReplay() {
+    replaying.store(false, std::memory_order_relaxed);
+}
+
+// Method to dispatch one event read from a journal
+void EventManager::replayEvent(const Event& event) {
+    if (statsEnabled.load(std::memory_order_relaxed)) {
+        stats.recordDispatched(event.getType());  // Replayed events never sat in the queue, so there is no queue time
+    }
+    ++dispatchDepth;
+    dispatchEvent(event, nullptr);
+    --dispatchDepth;
+    if (dispatchDepth == 0) {
+        applyPendingHandlerChanges();
+    }
+}
+
+// Method to release due scheduled events and dispatch all queued events
+void EventManager::dispatchEvents(int64_t currentTime) {
+    if (journal && dispatchDepth == 0) {
+        journal->recordFrame(currentTime);  // A dispatch from inside a handler is part of the running frame
+    }
+    eventQueue.collectIncoming();
+    eventQueue.releaseDueEvents(currentTime);
+    dispatchReadyEvents();
+    dispatchChannels();
+}
+
 // Method to dispatch all queued events to their respective handlers
 void EventManager::dispatchEvents() {
-    while (!eventQueue.isEmpty()) {
-        std::shared_ptr<Event> event = eventQueue.popEvent();
-        EventType eventType = event->getType();
-
-        // Dispatch the event to all registered handlers for its type
-        if (handlers.find(eventType) != handlers.end()) {
-            for (const auto& handler : handlers[eventType]) {
-                handler(event);
+    if (journal && dispatchDepth == 0) {
+        journal->recordFrame(EventJournal::UNTIMED_FRAME);
+    }
+    eventQueue.collectIncoming();
+    dispatchReadyEvents();
+    dispatchChannels();
+}
+
+// Method to dispatch the events already in the queue
+void EventManager::dispatchReadyEvents() {
+    typedef std::chrono::steady_clock Clock;
+    bool timed = maxDispatchTime.count() > 0;
+    Clock::time_point deadline = timed ? Clock::now() + maxDispatchTime : Clock::time_point();
+
+    ++dispatchDepth;
+    size_t dispatched = 0;
+    bool budgetSpent = false;
+    while (!budgetSpent) {
+        while (!eventQueue.isEmpty()) {
+            // Leave the rest (the lowest-priority events) for the next call once the budget is spent
+            if (dispatched > 0 && ((maxDispatchEvents > 0 && dispatched >= maxDispatchEvents) || (timed && Clock::now() >= deadline))) {
+                ++budgetExceededCount;
+                budgetSpent = true;
+                break;
             }
+
+            // Copy the event out, since handlers may raise new events into the queue
+            int64_t queuedAt = 0;
+            Event event = eventQueue.popEvent(&queuedAt);
+            if (statsEnabled.load(std::memory_order_relaxed)) {
+                stats.recordDispatched(event.getType());
+                if (queuedAt != 0) {  // Queued before stats were turned on, so there is no queue time to sample
+                    stats.recordQueueLatency(event.getType(), static_cast<uint64_t>(EventQueue::now() - queuedAt));
+                }
+            }
+            if (journal) {
+                journal->record(event);
+            }
+            if (replicatedTypes[event.getType()] && !event.isRemote()) {
+                replicatedEvents.push_back(event);
+            }
+            dispatchEvent(event, workerPool ? &concurrentEvents : nullptr);
+            ++dispatched;
+        }
+
+        // Events the concurrent handlers raise go back through the loop above
+        if (concurrentEvents.empty()) {
+            break;
+        }
+        runConcurrentHandlers();
+    }
+    --dispatchDepth;
+
+    if (dispatchDepth == 0) {
+        applyPendingHandlerChanges();
+
+        lastDispatchCount = dispatched;
+        backlog = eventQueue.size();
+        peakBacklog = std::max(peakBacklog, backlog);
+    }
+}
+
+// Method to invoke the handlers for one event
+void EventManager::dispatchEvent(const Event& event, std::vector<Event>* concurrentBatch) {
+    EventType eventType = event.getType();
+
+    EventStats* handlerStats = statsEnabled.load(std::memory_order_relaxed) ? &stats : nullptr;
+
+    // Object IDs belong to the client that raised the event, so remote events only reach remote handlers
+    if (event.isRemote()) {
+        invokeHandlers(remoteHandlers[eventType], event, handlerStats);
+        return;
+    }
+
+    // Dispatch the event to the handlers for its type, then to the handlers for its object
+    const std::vector<HandlerEntry>& entries = handlers[eventType];
+    const ObjectHandlerMap& objectEntries = objectHandlers[eventType];
+    const std::vector<HandlerEntry>& concurrentEntries = concurrentHandlers[eventType];
+    if (entries.empty() && objectEntries.empty() && concurrentEntries.empty()) {
+        std::cerr << "No handlers registered for event type: " << static_cast<int>(eventType) << std::endl;
+        return;
+    }
+
+    invokeHandlers(entries, event, handlerStats);
+    if (!objectEntries.empty()) {
+        auto it = objectEntries.find(event.getObjectID());
+        if (it != objectEntries.end()) {
+            invokeHandlers(it->second, event, handlerStats);
+        }
+    }
+
+    // The thread-safe handlers run later, on the worker pool, if there is one
+    if (!concurrentEntries.empty()) {
+        if (concurrentBatch) {
+            concurrentBatch->push_back(event);
         }
         else {
-            std::cerr << "No handlers registered for event type: " << static_cast<int>(eventType) << std::endl;
+            invokeHandlers(concurrentEntries, event, handlerStats);
         }
     }
+}
+
+// Method to run the concurrent handlers for the waiting events on the worker pool
+void EventManager::runConcurrentHandlers() {
+    // Every event about an object goes to the same lane, so each lane keeps its objects' events in order
+    size_t laneCount = (workerPool->getThreadCount() + 1) * LANES_PER_THREAD;
+    if (lanes.size() < laneCount) {
+        lanes.resize(laneCount);
+    }
+    for (size_t i = 0; i < laneCount; ++i) {
+        lanes[i].clear();
+    }
+    for (size_t i = 0; i < concurrentEvents.size(); ++i) {
+        uint32_t objectID = static_cast<uint32_t>(concurrentEvents[i].getObjectID());
+        lanes[objectID % laneCount].push_back(static_cast<uint32_t>(i));
+    }
+
+    // Handler lists cannot change meanwhile: changes made during dispatch are deferred
+    workerPool->run(laneCount,
+        [this](size_t lane) {
+            for (uint32_t index : lanes[lane]) {
+                const Event& event = concurrentEvents[index];
+                invokeHandlers(concurrentHandlers[event.getType()], event, nullptr);
+            }
+        },
+        [this]() {
+            // Drain events raised on the workers, so a full ring never blocks them
+            eventQueue.collectIncoming();
+        });
+
+    eventQueue.collectIncoming();
+    concurrentEvents.clear();
+}
+
+// Method to dispatch the typed event channels
+void EventManager::dispatchChannels() {
+    // A handler may raise into a channel that was already dispatched, so go round until all are quiet
+    size_t dispatched;
+    do {
+        dispatched = 0;
+        // Channels created by another thread while dispatching are picked up on the next round
+        size_t channelCount = publishedChannelCount.load(std::memory_order_acquire);
+        for (size_t i = 0; i < channelCount; ++i) {
+            dispatched += channels[channelOrder[i]].load(std::memory_order_relaxed)->dispatch();
+        }
+    } while (dispatched > 0);
 }
\ No newline at end of file
@@ -1,32 +1,65 @@
 #ifndef EVENT_MANAGER_H
 #define EVENT_MANAGER_H
 
-#include <unordered_map>
+#include <array>
 #include <vector>
+#include <unordered_map>
 #include <functional>
-#include <memory>
 #include <string>
+#include <cstdint>
+#include <climits>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
 #include <zmq.hpp>
 #include "EventQueue.h"
 #include "Event.h"
+#include "Subscription.h"
+#include "EventJournal.h"
+#include "EventStats.h"
+#include "WorkerPool.h"
+#include "EventChannel.h"
 
 /**
  * @brief The EventManager class for managing event listeners, raising events, dispatching events, and handling networked events.
  *
  * The EventManager class is responsible for managing the entire event-handling system. It allows
  * for the registration of handlers for specific event types, raising new events, and dispatching
- * queued events to the appropriate handlers. As a singleton, this class ensures there is a
- * centralized instance that can be accessed globally within the application.
+ * queued events to the appropriate handlers. Handlers can listen to every event of a type, or
+ * only to the events about one object; the latter are found through a per-type index on the
+ * event's object ID, so an event only reaches the handlers that care about its object. Each World owns its own EventManager, so events
+ * raised in one world are only ever dispatched to handlers registered in that world.
+ *
+ * Events are copied into the queue by value and handlers receive a const reference, so raising
+ * and dispatching events involves no heap allocation or reference counting once the queue has
+ * grown to its peak size.
+ *
+ * raiseEvent() and scheduleEvent() are safe to call from any thread (worker threads, network
+ * receive loops, platform threads) and never take a lock. Events raised on other threads are
+ * dispatched, on the thread that calls dispatchEvents(), at its next call. Registering handlers
+ * and dispatching must happen on that one thread.
+ *
+ * Handlers registered with subscribeConcurrent() promise to be thread-safe; with a WorkerPool
+ * set, the manager runs them on the pool's threads, keeping each object's events in order.
+ *
+ * Besides the EventType events, the manager carries typed events: any plain struct can be raised
+ * with raise<T>() and handled with subscribe<T>(), which receive the struct itself. Each struct
+ * type has its own EventChannel, so adding one needs no change here or in EventType.
  */
 class EventManager {
 public:
     /**
      * @brief Default constructor for EventManager.
      *
-     * Initializes the event manager without any specific setup. Since EventManager is a singleton,
-     * this constructor is only called internally.
+     * Reserves room for a typical frame's worth of events so raising events does not allocate.
      */
-    EventManager() = default;
+    EventManager() {
+        eventQueue.reserve(INITIAL_EVENT_CAPACITY);
+        for (std::atomic<IEventChannel*>& channel : channels) {
+            channel.store(nullptr, std::memory_order_relaxed);
+        }
+    }
 
     /**
      * @brief Default destructor for EventManager.
@@ -36,63 +69,538 @@ public:
     ~EventManager() = default;
 
     /**
-     * @brief Singleton instance accessor for EventManager.
+     * @brief Registers a handler for a specific event type.
+     *
+     * This method associates a callback function with a specified event type. When an event of
+     * that type is dispatched, the registered handler will be invoked. The handler stays
+     * registered only while the returned Subscription is kept alive, so store it (typically as a
+     * member of the object the handler calls into).
+     *
+     * Handlers added or removed while events are being dispatched take effect once the current
+     * dispatch finishes.
+     *
+     * @param eventType The type of event to register the handler for.
+     * @param handler A function to handle the event. Construct the derived event type from the
+     *        Event it receives (e.g. InputEvent inputEvent(event)) to use its typed getters.
+     * @return The token that keeps the handler registered.
+     */
+    Subscription subscribe(EventType eventType, std::function<void(const Event&)> handler);
+
+    /**
+     * @brief Registers a handler for the events of a type that are about one object.
      *
-     * This function provides access to the singleton instance of EventManager. Ensures there is
-     * only one instance of EventManager in the application.
+     * The handler is only invoked for events whose getObjectID() equals objectID, and finding it
+     * costs one hash lookup however many objects have handlers. Use it instead of a handler that
+     * checks which object an event is about.
      *
-     * @return EventManager& Reference to the singleton instance of EventManager.
+     * @param eventType The type of event to register the handler for.
+     * @param objectID The object whose events the handler receives.
+     * @param handler A function to handle the event.
+     * @return The token that keeps the handler registered.
      */
-    static EventManager& getInstance() {
-        static EventManager instance;
-        return instance;
-    }
+    Subscription subscribe(EventType eventType, int objectID, std::function<void(const Event&)> handler);
 
     /**
-     * @brief Registers a handler for a specific event type.
+     * @brief Registers a handler for the events of a type raised by other clients.
      *
-     * This method associates a callback function with a specified event type. When an event of
-     * that type is dispatched, the registered handler will be invoked.
+     * Events received from the network (see NetworkEventBus) carry object IDs from the world of
+     * the client that raised them, so they are never passed to the handlers registered with
+     * subscribe(); only remote handlers see them. Use Event::getSource() to tell the clients apart.
+     *
+     * @param eventType The type of event to register the handler for.
+     * @param handler A function to handle the event.
+     * @return The token that keeps the handler registered.
+     */
+    Subscription subscribeRemote(EventType eventType, std::function<void(const Event&)> handler);
+
+    /**
+     * @brief Registers a thread-safe handler that may run on a worker thread.
+     *
+     * With a worker pool set (see setWorkerPool()), the events a dispatchEvents() call hands to
+     * concurrent handlers are split into lanes by object ID and the lanes run in parallel, after
+     * the call's other handlers have seen the events. Events about the same object always share a
+     * lane, so they reach the handler in dispatch order and never at the same time; events about
+     * different objects may be handled concurrently. Events the handlers raise are dispatched in
+     * the same call, as usual. Without a pool, concurrent handlers run like any other handler.
+     *
+     * A concurrent handler may raise and schedule events, but must not subscribe, unsubscribe or
+     * dispatch, and anything it shares with handlers for other objects must be synchronized. It
+     * only receives local events, and its running time is not recorded in the statistics.
      *
      * @param eventType The type of event to register the handler for.
-     * @param handler A function to handle the event, accepting a shared pointer to the Event object.
+     * @param handler A thread-safe function to handle the event.
+     * @return The token that keeps the handler registered.
+     */
+    Subscription subscribeConcurrent(EventType eventType, std::function<void(const Event&)> handler);
+
+    /**
+     * @brief Sets the worker pool that runs the concurrent handlers.
+     *
+     * @param workerPool The pool, or nullptr to run concurrent handlers on the dispatching thread.
+     *        The manager does not own it, and only this manager may hand it work while it is set.
+     */
+    void setWorkerPool(WorkerPool* workerPool);
+
+    /**
+     * @brief Registers a handler for a typed event.
+     *
+     * Typed events are dispatched by dispatchEvents() after the EventType events, one channel
+     * at a time in the order the channels were first used, each channel in the order its events
+     * were raised. They skip the priority queue, scheduling, coalescing, the journal,
+     * replication, the worker pool and the statistics.
+     *
+     * Example: Subscription s = eventManager.subscribe<ScoreEvent>([](const ScoreEvent& score) { ... });
+     *
+     * @param handler A function to handle the event; it receives the struct with no cast.
+     * @return The token that keeps the handler registered.
+     */
+    template <typename T>
+    Subscription subscribe(std::function<void(const T&)> handler) {
+        uint32_t id = nextHandlerID++;
+        getChannel<T>().subscribe(id, std::move(handler));
+        return Subscription(this, TYPED_EVENTS, static_cast<int>(EventChannel<T>::getID()), id);
+    }
+
+    /**
+     * @brief Raises a typed event.
+     *
+     * Safe to call from any thread, including before the event type's channel exists: the channel
+     * table has a fixed size and channels are published through atomics, so finding a channel
+     * never races with another one being created.
+     *
+     * @param event The event; it is copied into the channel.
+     * @return True if the event was queued, false if the channel's ring stayed full and it was dropped.
+     */
+    template <typename T>
+    bool raise(const T& event) {
+        return getChannel<T>().raise(event);
+    }
+
+    /**
+     * @brief Passes every queued typed event of a type to one handler, bypassing subscribe<T>().
+     *
+     * The handler's call is inlined into the loop over the channel's contiguous events.
+     *
+     * @param handler Called with each event, oldest first.
+     * @return The number of events handled.
+     */
+    template <typename T, typename Handler>
+    size_t drain(Handler&& handler) {
+        return getChannel<T>().drain(std::forward<Handler>(handler));
+    }
+
+    /**
+     * @brief Accessor for the channel of a typed event, creating it on first use.
+     *
+     * Finding an existing channel is one atomic load, so it is safe from any thread.
+     *
+     * @return The channel.
      */
-    void registerHandler(EventType eventType, std::function<void(std::shared_ptr<Event>)> handler);
+    template <typename T>
+    EventChannel<T>& getChannel() {
+        size_t channelID = EventChannel<T>::getID();
+        IEventChannel* channel = channels[channelID].load(std::memory_order_acquire);
+        if (!channel) {
+            // Rare: only the first use of each type gets here, so a lock is fine
+            std::lock_guard<std::mutex> lock(channelMutex);
+            channel = channels[channelID].load(std::memory_order_relaxed);
+            if (!channel) {
+                ownedChannels.emplace_back(new EventChannel<T>(eventQueue.getConsumerThread()));
+                channel = ownedChannels.back().get();
+                size_t channelCount = publishedChannelCount.load(std::memory_order_relaxed);
+                channelOrder[channelCount] = channelID;
+                channels[channelID].store(channel, std::memory_order_release);
+                publishedChannelCount.store(channelCount + 1, std::memory_order_release);
+            }
+        }
+        return static_cast<EventChannel<T>&>(*channel);
+    }
 
     /**
-     * @brief Raises an event by adding it to the event queue.
+     * @brief Gets the number of handlers registered for an event type.
+     *
+     * @param eventType The event type.
+     * @param objectID The object to count the handlers of, or Event::NO_OBJECT to count the
+     *        handlers that receive every event of the type.
+     * @return The number of registered handlers, including changes still pending from a dispatch.
+     */
+    size_t getHandlerCount(EventType eventType, int objectID = Event::NO_OBJECT) const;
+
+    /**
+     * @brief Raises an event by adding it to the event queue. Safe to call from any thread.
      *
      * Adds an event to the EventManagers event queue, where it will be dispatched during the
      * dispatching process.
      *
-     * @param event A shared pointer to the Event object being raised.
+     * @param event The event being raised; it is copied into the queue.
+     */
+    void raiseEvent(const Event& event);
+
+    /**
+     * @brief Schedules an event to be dispatched after a delay. Safe to call from any thread.
+     *
+     * The event is held back until dispatchEvents(currentTime) is called with a time at least
+     * delay milliseconds after the event's timestamp, then dispatched in priority order with the
+     * other ready events. Use it for delayed respawns, timed waves and similar effects.
+     *
+     * @param event The event being scheduled; it is copied into the queue.
+     * @param delay The delay in milliseconds, on the timeline that stamped the event.
      */
-    void raiseEvent(std::shared_ptr<Event> event);
+    void scheduleEvent(const Event& event, int64_t delay);
 
     /**
      * @brief Dispatches all queued events to their respective handlers.
      *
      * Iterates through the event queue and dispatches each event to its registered handlers. This
      * process invokes the callbacks associated with each event type, allowing them to be handled
-     * accordingly.
+     * accordingly. If a dispatch budget is set, only as many events as fit in it are dispatched.
      */
     void dispatchEvents();
 
+    /**
+     * @brief Releases scheduled events that are due, then dispatches all queued events.
+     *
+     * @param currentTime The current time on the timeline that stamped the scheduled events.
+     */
+    void dispatchEvents(int64_t currentTime);
+
+    /**
+     * @brief Limits how much work a single dispatchEvents() call may do.
+     *
+     * Once either limit is reached, dispatching stops and the remaining events stay queued for
+     * the next call. Events come out highest priority first, so the events carried over are the
+     * lowest-priority ones. At least one event is dispatched per call, so the queue always drains
+     * eventually. Pass 0 for both limits (the default) to drain the whole queue every call.
+     *
+     * @param maxEvents The most events dispatched per call, or 0 for no count limit.
+     * @param maxMicroseconds The longest a call may keep dispatching, or 0 for no time limit.
+     */
+    void setDispatchBudget(size_t maxEvents, int64_t maxMicroseconds);
+
+    /**
+     * @brief Gets the number of events left queued by the last dispatchEvents() call.
+     *
+     * @return The number of ready events waiting for the next dispatch.
+     */
+    size_t getBacklog() const;
+
+    /**
+     * @brief Gets the largest backlog any dispatchEvents() call has left behind.
+     *
+     * @return The peak backlog.
+     */
+    size_t getPeakBacklog() const;
+
+    /**
+     * @brief Gets the number of events the last dispatchEvents() call dispatched.
+     *
+     * @return The number of dispatched events.
+     */
+    size_t getLastDispatchCount() const;
+
+    /**
+     * @brief Gets the number of dispatchEvents() calls that stopped because of the budget.
+     *
+     * @return The number of budget-limited dispatches.
+     */
+    uint64_t getBudgetExceededCount() const;
+
+    /**
+     * @brief Turns event instrumentation on or off.
+     *
+     * While on, the manager counts raised and dispatched events per type and records how long
+     * each event waited in the ready queue and how long each handler ran (see getStats()). While
+     * off, the only cost is one flag check per raised and dispatched event. Turning it off keeps
+     * the numbers gathered so far.
+     *
+     * @param enabled True to record statistics.
+     */
+    void setStatsEnabled(bool enabled);
+
+    /**
+     * @brief Checks whether event instrumentation is on.
+     *
+     * @return True if statistics are being recorded.
+     */
+    bool isStatsEnabled() const;
+
+    /**
+     * @brief Accessor for the recorded statistics; read or clear them on the dispatching thread.
+     *
+     * @return The statistics, which can also be written to a file with EventStats::writeReport().
+     */
+    EventStats& getStats();
+
+    /**
+     * @brief Turns coalescing on or off for an event type.
+     *
+     * While an event of a coalescing type is waiting to be dispatched, raising another event of
+     * that type with the same merge key (see Event::getMergeKey()) does nothing, so the handlers
+     * run once per key per dispatch. The waiting event keeps its own timestamp and priority. Use
+     * it for event types that are raised every frame or once per contact, like INPUT and COLLISION.
+     *
+     * @param eventType The event type.
+     * @param enabled True to merge duplicate events of the type.
+     */
+    void setCoalescing(EventType eventType, bool enabled);
+
+    /**
+     * @brief Gets the number of raised events that were merged into an event already waiting.
+     *
+     * @return The number of merged events.
+     */
+    uint64_t getMergedEventCount() const;
+
+    /**
+     * @brief Turns replication to other clients on or off for an event type.
+     *
+     * Locally raised events of a replicated type are collected as they are dispatched, for
+     * takeReplicatedEvents() to hand to the network. Events received from other clients are
+     * never collected again.
+     *
+     * @param eventType The event type.
+     * @param replicated True to replicate the event type.
+     */
+    void setReplicated(EventType eventType, bool replicated);
+
+    /**
+     * @brief Checks whether an event type is replicated.
+     *
+     * @param eventType The event type.
+     * @return True if events of the type are collected for other clients.
+     */
+    bool isReplicated(EventType eventType) const;
+
+    /**
+     * @brief Hands over the replicated events dispatched since the last call.
+     *
+     * @param events Cleared, then filled with the events in dispatch order. Pass the same vector
+     *        every time so its memory is reused.
+     */
+    void takeReplicatedEvents(std::vector<Event>& events);
+
+    /**
+     * @brief Records every dispatched event to a journal.
+     *
+     * Events are recorded in the order they reach the handlers, with their timestamps and
+     * payloads, so replaying the journal invokes the same handlers in the same order. Each
+     * dispatchEvents() call starts with a frame marker holding its current time, so replayFrame()
+     * can hand the events back one frame at a time.
+     *
+     * @param journal An open journal, or nullptr to stop recording. The manager does not own it.
+     */
+    void setJournal(EventJournal* journal);
+
+    /**
+     * @brief Dispatches every event of a journal to the registered handlers, as fast as they run.
+     *
+     * The journal already holds the events the handlers raised while it was recorded, so events
+     * raised or scheduled during the replay are discarded instead of being dispatched twice.
+     * Handler changes made by a handler apply before the next recorded event, as they would have
+     * by the next frame of the recorded session. Events queued before the replay stay queued.
+     *
+     * @param reader An open journal reader.
+     * @return The number of events replayed.
+     */
+    uint64_t replay(EventJournalReader& reader);
+
+    /**
+     * @brief Dispatches the events of the next recorded frame: those one dispatchEvents() call dispatched.
+     *
+     * Call it once per step of the game, in place of dispatchEvents(), and run the game's update
+     * between calls, so the handlers and the game logic interleave as they did when recording.
+     * From the first call until the end of the journal (or endReplay()), raised and scheduled
+     * events are discarded, as with replay(); that includes the events the game's update raises
+     * between frames, which the journal also holds.
+     *
+     * @param reader An open journal reader.
+     * @param currentTime Receives the time the frame was dispatched at (EventJournal::UNTIMED_FRAME if none was given).
+     * @return True if a frame was replayed, false at the end of the journal.
+     */
+    bool replayFrame(EventJournalReader& reader, int64_t& currentTime);
+
+    /**
+     * @brief Stops a frame-by-frame replay early, so raised events are queued again.
+     */
+    void endReplay();
+
 private:
+    friend class Subscription;
+
     /**
-     * @brief Deleted copy constructor to enforce singleton pattern.
+     * @brief A registered handler.
+     */
+    struct HandlerEntry {
+        uint32_t id;                               // ID shared with the handler's Subscription
+        std::function<void(const Event&)> handler; // The handler itself
+        bool active;                               // False once unsubscribed during a dispatch
+    };
+
+    /**
+     * @brief A handler subscribed during dispatch, waiting to be added to its list.
+     */
+    struct PendingHandler {
+        EventType eventType; // Event type the handler is registered for
+        int objectID;        // Key of the handler's list: an object ID, Event::NO_OBJECT, REMOTE_EVENTS or CONCURRENT_EVENTS
+        HandlerEntry entry;  // The handler itself
+    };
+
+    typedef std::unordered_map<int, std::vector<HandlerEntry>> ObjectHandlerMap;
+
+    /**
+     * @brief Registers a handler in the list for a key.
+     *
+     * @param eventType The event type.
+     * @param key An object ID, Event::NO_OBJECT for every local event, REMOTE_EVENTS or CONCURRENT_EVENTS.
+     * @param handler The handler.
+     * @return The token that keeps the handler registered.
+     */
+    Subscription addHandler(EventType eventType, int key, std::function<void(const Event&)> handler);
+
+    /**
+     * @brief Invokes the active handlers in a list.
+     *
+     * @param entries The handlers.
+     * @param event The event to pass to them.
+     * @param stats Statistics to record each handler's running time in, or nullptr.
+     */
+    static void invokeHandlers(const std::vector<HandlerEntry>& entries, const Event& event, EventStats* stats);
+
+    /**
+     * @brief Gets the handler list for an event type and object.
+     *
+     * @param eventType The event type.
+     * @param objectID The object, Event::NO_OBJECT for the list that receives every local event,
+     *        REMOTE_EVENTS for the list that receives events from other clients, or
+     *        CONCURRENT_EVENTS for the thread-safe handlers.
+     * @return The list, or nullptr if no handler was ever added for that object.
+     */
+    std::vector<HandlerEntry>* findHandlers(EventType eventType, int objectID);
+    const std::vector<HandlerEntry>* findHandlers(EventType eventType, int objectID) const;
+
+    /**
+     * @brief Gets the handler list for an event type and key, adding an object's list if needed.
+     *
+     * @param eventType The event type.
+     * @param key An object ID, Event::NO_OBJECT, REMOTE_EVENTS or CONCURRENT_EVENTS.
+     * @return The list.
+     */
+    std::vector<HandlerEntry>& getOrCreateHandlers(EventType eventType, int key);
+
+    /**
+     * @brief Removes an object's handler list from the index once it is empty.
+     *
+     * @param eventType The event type.
+     * @param key The key of the list.
+     */
+    void releaseEmptyHandlers(EventType eventType, int key);
+
+    /**
+     * @brief Dispatches the events already in the queue, in priority order.
+     */
+    void dispatchReadyEvents();
+
+    /**
+     * @brief Invokes the handlers for one event.
+     *
+     * @param event The event to dispatch.
+     * @param concurrentBatch Where to leave the event for the worker pool if it has concurrent
+     *        handlers, or nullptr to invoke them right away.
+     */
+    void dispatchEvent(const Event& event, std::vector<Event>* concurrentBatch);
+
+    /**
+     * @brief Runs the concurrent handlers for the events in concurrentEvents on the worker pool.
+     *
+     * Returns once every lane has finished, with the events the handlers raised in the queue.
+     */
+    void runConcurrentHandlers();
+
+    /**
+     * @brief Dispatches the typed event channels until none has events left.
+     */
+    void dispatchChannels();
+
+    /**
+     * @brief Dispatches one event read from a journal.
+     */
+    void replayEvent(const Event& event);
+
+    /**
+     * @brief Removes a handler; called by Subscription.
+     *
+     * @param eventType The event type the handler is registered for.
+     * @param objectID The object the handler is registered for (Event::NO_OBJECT for all).
+     * @param id The ID of the handler.
+     */
+    void unsubscribe(EventType eventType, int objectID, uint32_t id);
+
+    /**
+     * @brief Applies the handler additions and removals deferred during dispatch.
+     */
+    void applyPendingHandlerChanges();
+
+    /**
+     * @brief Deleted copy constructor; registered handlers belong to this manager only.
      */
     EventManager(const EventManager&) = delete;
 
     /**
-     * @brief Deleted assignment operator to enforce singleton pattern.
+     * @brief Deleted assignment operator; registered handlers belong to this manager only.
      */
     EventManager& operator=(const EventManager&) = delete;
 
+    static const size_t INITIAL_EVENT_CAPACITY = 256; // Events reserved up front
+    static const int REMOTE_EVENTS = INT_MIN;          // Handler key of the lists for events from other clients
+    static const int CONCURRENT_EVENTS = INT_MIN + 1;  // Handler key of the lists of thread-safe handlers
+    static const EventType TYPED_EVENTS = EVENT_TYPE_COUNT; // Subscription event type of typed handlers (keyed by channel ID)
+    static const size_t LANES_PER_THREAD = 4;          // Lanes per pool thread, so uneven lanes balance out
+
     EventQueue eventQueue; // Queue to manage events, allowing them to be dispatched in sequence.
 
-    /// Map storing event handlers for each event type. Each event type can have multiple handlers.
-    std::unordered_map<EventType, std::vector<std::function<void(std::shared_ptr<Event>)>>> handlers;
+    /// Handlers for each event type, indexed by EventType. Each event type can have multiple handlers.
+    std::array<std::vector<HandlerEntry>, EVENT_TYPE_COUNT> handlers;
+
+    /// Handlers for single objects, indexed by EventType and then by object ID.
+    std::array<ObjectHandlerMap, EVENT_TYPE_COUNT> objectHandlers;
+
+    /// Handlers for events raised by other clients, indexed by EventType.
+    std::array<std::vector<HandlerEntry>, EVENT_TYPE_COUNT> remoteHandlers;
+
+    /// Thread-safe handlers run on the worker pool, indexed by EventType.
+    std::array<std::vector<HandlerEntry>, EVENT_TYPE_COUNT> concurrentHandlers;
+
+    WorkerPool* workerPool = nullptr;         // Pool running the concurrent handlers, if any
+    std::vector<Event> concurrentEvents;      // Events waiting for their concurrent handlers, in dispatch order
+    std::vector<std::vector<uint32_t>> lanes; // Indices into concurrentEvents, one list per lane
+
+    // Typed event channels. The table never moves, so raise<T>() can read it from any thread while
+    // a channel is being created; creation is serialised by channelMutex.
+    std::atomic<IEventChannel*> channels[IEventChannel::MAX_CHANNELS]; // Channels by channel ID, or nullptr
+    size_t channelOrder[IEventChannel::MAX_CHANNELS];                  // IDs of the existing channels, in creation order
+    std::atomic<size_t> publishedChannelCount{ 0 };                    // Entries of channelOrder that are filled in
+    std::vector<std::unique_ptr<IEventChannel>> ownedChannels;         // Owns the channels (guarded by channelMutex)
+    std::mutex channelMutex;                                           // Serialises creating channels
+
+    bool replicatedTypes[EVENT_TYPE_COUNT] = {}; // Event types sent to other clients
+    std::vector<Event> replicatedEvents;         // Replicated events dispatched since the last takeReplicatedEvents()
+    std::vector<PendingHandler> pendingHandlers; // Handlers subscribed during dispatch
+    std::vector<std::pair<EventType, int>> pendingRemovals; // Lists a handler was unsubscribed from during dispatch
+    int dispatchDepth = 0;           // Number of dispatch loops currently running (handlers may dispatch)
+    uint32_t nextHandlerID = 1;      // ID for the next subscribed handler
+
+    size_t maxDispatchEvents = 0;          // Events dispatched per call before stopping (0 for no limit)
+    std::chrono::microseconds maxDispatchTime{ 0 }; // Time spent per call before stopping (0 for no limit)
+    size_t backlog = 0;                    // Ready events left by the last dispatch
+    size_t peakBacklog = 0;                // Largest backlog left by any dispatch
+    size_t lastDispatchCount = 0;          // Events dispatched by the last dispatch
+    uint64_t budgetExceededCount = 0;      // Dispatches that stopped because of the budget
+
+    EventStats stats;                      // Counters and histograms, recorded while statsEnabled is set
+    std::atomic<bool> statsEnabled{ false }; // Whether statistics are recorded (read by raising threads)
+
+    EventJournal* journal = nullptr;       // Journal recording dispatched events, if any
+    std::atomic<bool> replaying{ false };  // Whether a journal is being replayed (raised events are discarded)
 };
 
 #endif // EVENT_MANAGER_H
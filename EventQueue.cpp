@@ -1,21 +1,162 @@
 #include "EventQueue.h"
+#include <algorithm>
+#include <chrono>
+
+// Constructor
+EventQueue::EventQueue()
+    : incomingEvents(INCOMING_CAPACITY), consumerThread(std::this_thread::get_id()) {
+    pendingKeys.reserve(INITIAL_PENDING_KEYS);
+}
 
 // Method to push a new event onto the queue
-void EventQueue::pushEvent(std::shared_ptr<Event> event) {
-    eventQueue.push(event);
+void EventQueue::pushEvent(const Event& event) {
+    if (!onConsumerThread()) {
+        pushIncoming({ event, 0, stamp(), false });
+        return;
+    }
+    pushReady(event, stamp());
+}
+
+// Method to schedule an event for a later time
+void EventQueue::scheduleEvent(const Event& event, int64_t dueTime) {
+    if (!onConsumerThread()) {
+        pushIncoming({ event, dueTime, 0, true });
+        return;
+    }
+    scheduledEvents.push({ event, dueTime, nextSequence++ });
+}
+
+// Method to collect events raised by other threads
+size_t EventQueue::collectIncoming() {
+    consumerThread.store(std::this_thread::get_id(), std::memory_order_relaxed);
+
+    size_t collected = 0;
+    IncomingEvent incomingEvent = { Event(INPUT, 0, nullptr), 0, 0, false };
+    while (incomingEvents.tryPop(incomingEvent)) {
+        if (incomingEvent.scheduled) {
+            scheduledEvents.push({ incomingEvent.event, incomingEvent.dueTime, nextSequence++ });
+        }
+        else {
+            pushReady(incomingEvent.event, incomingEvent.queuedAt);
+        }
+        ++collected;
+    }
+    return collected;
+}
+
+// Method to move due scheduled events into the queue
+size_t EventQueue::releaseDueEvents(int64_t currentTime) {
+    size_t released = 0;
+    while (!scheduledEvents.empty() && scheduledEvents.top().dueTime <= currentTime) {
+        pushReady(scheduledEvents.pop().event, stamp());
+        ++released;
+    }
+    return released;
 }
 
 // Method to pop an event from the queue
-std::shared_ptr<Event> EventQueue::popEvent() {
-    if (eventQueue.empty()) {
-        return nullptr;
+Event EventQueue::popEvent(int64_t* queuedAt) {
+    ReadyEvent readyEvent = readyEvents.pop();
+    const Event& event = readyEvent.event;
+    if (queuedAt) {
+        *queuedAt = readyEvent.queuedAt;
+    }
+    if (coalescedTypes[event.getType()]) {
+        // The event is leaving the queue, so the next equal event is queued again
+        uint64_t key = event.getMergeKey();
+        for (size_t i = 0; i < pendingKeys.size(); ++i) {
+            if (pendingKeys[i].type == event.getType() && pendingKeys[i].source == event.getSource() && pendingKeys[i].key == key) {
+                pendingKeys[i] = pendingKeys.back();
+                pendingKeys.pop_back();
+                break;
+            }
+        }
     }
-    auto event = eventQueue.front();
-    eventQueue.pop();
     return event;
 }
 
 // Method to check if the event queue is empty
 bool EventQueue::isEmpty() const {
-    return eventQueue.empty();
+    return readyEvents.empty();
+}
+
+// Method to get the number of ready events
+size_t EventQueue::size() const {
+    return readyEvents.size();
+}
+
+// Method to get the number of scheduled events that are not due yet
+size_t EventQueue::getScheduledCount() const {
+    return scheduledEvents.size();
+}
+
+// Method to pre-allocate room for events
+void EventQueue::reserve(size_t capacity) {
+    readyEvents.reserve(capacity);
+    scheduledEvents.reserve(capacity);
+}
+
+// Method to turn coalescing on or off for an event type
+void EventQueue::setCoalescing(EventType eventType, bool enabled) {
+    coalescedTypes[eventType] = enabled;
+    if (!enabled) {
+        // Waiting events of the type no longer release their keys when popped
+        pendingKeys.erase(std::remove_if(pendingKeys.begin(), pendingKeys.end(),
+            [eventType](const PendingKey& pending) { return pending.type == eventType; }), pendingKeys.end());
+    }
+}
+
+// Method to get the number of merged events
+uint64_t EventQueue::getMergedCount() const {
+    return mergedCount;
+}
+
+// Method to add an event to the ready heap, merging it into an equal waiting event
+void EventQueue::pushReady(const Event& event, int64_t queuedAt) {
+    if (coalescedTypes[event.getType()]) {
+        // Only a frame's worth of input and contacts wait at once, so a linear scan is cheapest
+        uint64_t key = event.getMergeKey();
+        for (const PendingKey& pending : pendingKeys) {
+            if (pending.type == event.getType() && pending.source == event.getSource() && pending.key == key) {
+                ++mergedCount;
+                return;
+            }
+        }
+        pendingKeys.push_back({ event.getType(), event.getSource(), key });
+    }
+    readyEvents.push({ event, nextSequence++, queuedAt });
+}
+
+// Method to turn queue timing on or off
+void EventQueue::setTiming(bool enabled) {
+    timing.store(enabled, std::memory_order_relaxed);
+}
+
+// Method to read the queue timing clock
+int64_t EventQueue::now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Method to read the clock if timing is on
+int64_t EventQueue::stamp() const {
+    return timing.load(std::memory_order_relaxed) ? now() : 0;
+}
+
+// Method to add an event from another thread to the incoming ring
+void EventQueue::pushIncoming(const IncomingEvent& incomingEvent) {
+    // Only a producer that outruns a whole frame of dispatching ever waits here, and it never
+    // holds anything the consumer needs
+    while (!incomingEvents.tryPush(incomingEvent)) {
+        std::this_thread::yield();
+    }
+}
+
+// Method to get the consumer thread
+std::thread::id EventQueue::getConsumerThread() const {
+    return consumerThread.load(std::memory_order_relaxed);
+}
+
+// Method to check whether the calling thread is the consumer
+bool EventQueue::onConsumerThread() const {
+    return consumerThread.load(std::memory_order_relaxed) == std::this_thread::get_id();
 }
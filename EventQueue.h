@@ -1,9 +1,14 @@
 #ifndef EVENT_QUEUE_H
 #define EVENT_QUEUE_H
 
-#include <queue>
-#include <memory>
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <thread>
+#include <vector>
 #include "Event.h"  // Assuming Event is defined elsewhere
+#include "DaryHeap.h"
+#include "MpscRingBuffer.h"
 
 /**
  * @brief Comparator for the priority queue to order events based on priority and timestamp.
@@ -20,13 +25,13 @@ struct EventCompare {
      * @param rhs The right-hand side event to compare.
      * @return True if lhs has lower priority or a later timestamp than rhs, false otherwise.
      */
-    bool operator()(const std::shared_ptr<Event>& lhs, const std::shared_ptr<Event>& rhs) const {
-        if (lhs->getPriority() == rhs->getPriority()) {
+    bool operator()(const Event& lhs, const Event& rhs) const {
+        if (lhs.getPriority() == rhs.getPriority()) {
             // Earlier timestamps have higher priority
-            return lhs->getTimestamp() > rhs->getTimestamp();
+            return lhs.getTimestamp() > rhs.getTimestamp();
         }
         // Higher priority number means higher priority
-        return lhs->getPriority() < rhs->getPriority();
+        return lhs.getPriority() < rhs.getPriority();
     }
 };
 
@@ -35,40 +40,237 @@ struct EventCompare {
  *
  * This class is responsible for managing events in a queue, allowing them to be added (pushed),
  * removed (popped), and checked for emptiness. Events are prioritized based on their priority
- * and timestamp, with higher priority events processed first.
+ * and timestamp, with higher priority events processed first; events that tie on both come out
+ * in the order they were pushed.
+ *
+ * Events can also be scheduled for a future time. Scheduled events wait in a separate heap keyed
+ * by due time and join the ready events once releaseDueEvents() is called with a time at or past
+ * their due time. Both heaps are 4-ary heaps, so pushes and pops stay logarithmic and cache
+ * friendly with thousands of pending events.
+ *
+ * Event types can be set to coalesce: while an event of such a type is waiting in the ready heap,
+ * further events of that type with the same merge key (see Event::getMergeKey()) are merged into
+ * it instead of being queued, so repeated input or contacts are handled once per dispatch.
+ *
+ * Events are stored by value inside the heaps' arrays, so a frame's events live in one contiguous
+ * block. Popping keeps the block's memory, and the next frame reuses it without allocating.
+ *
+ * pushEvent() and scheduleEvent() may be called from any thread. The thread that last called
+ * collectIncoming() is the consumer: its events go straight into the heaps, while events from
+ * other threads go through a lock-free ring and join the heaps at the next collectIncoming().
+ * Every other method must only be called from the consumer thread.
  */
 class EventQueue {
 public:
+    /**
+     * @brief Constructs an empty queue owned by the calling thread.
+     */
+    EventQueue();
     /**
      * @brief Pushes a new event onto the queue.
      *
      * Adds an event to the queue, where it will be prioritized based on the EventCompare
      * comparator. Events with higher priority or earlier timestamps are placed ahead.
      *
-     * @param event The event to be added to the queue.
+     * @param event The event to be added to the queue (copied).
+     */
+    void pushEvent(const Event& event);
+
+    /**
+     * @brief Schedules an event to join the queue at a later time.
+     *
+     * @param event The event to be added to the queue (copied).
+     * @param dueTime The time, on the timeline that stamped the event, at which the event becomes ready.
      */
-    void pushEvent(std::shared_ptr<Event> event);
+    void scheduleEvent(const Event& event, int64_t dueTime);
+
+    /**
+     * @brief Makes the calling thread the consumer and moves events raised by other threads into the queue.
+     *
+     * @return The number of events collected.
+     */
+    size_t collectIncoming();
+
+    /**
+     * @brief Moves every scheduled event whose due time has been reached into the queue.
+     *
+     * @param currentTime The current time on the timeline that stamped the scheduled events.
+     * @return The number of events released.
+     */
+    size_t releaseDueEvents(int64_t currentTime);
 
     /**
      * @brief Pops an event from the queue.
      *
-     * Removes the highest-priority event from the queue and returns it.
+     * Removes the highest-priority event from the queue and returns it. The queue must not be empty.
      *
-     * @return A shared pointer to the highest-priority event, or nullptr if the queue is empty.
+     * @param queuedAt If not null, receives the steady-clock time in nanoseconds at which the event
+     *        entered the ready queue, or 0 if timing was off at the time.
+     * @return The highest-priority event.
      */
-    std::shared_ptr<Event> popEvent();
+    Event popEvent(int64_t* queuedAt = nullptr);
 
     /**
      * @brief Checks if the event queue is empty.
      *
-     * This method allows checking whether the queue has any remaining events.
+     * This method allows checking whether the queue has any remaining events. Scheduled events
+     * that are not due yet are not counted.
      *
      * @return True if the queue is empty, false otherwise.
      */
     bool isEmpty() const;
 
+    /**
+     * @brief Gets the number of events ready to be popped.
+     *
+     * @return The number of ready events.
+     */
+    size_t size() const;
+
+    /**
+     * @brief Gets the number of scheduled events that are not due yet.
+     *
+     * @return The number of scheduled events.
+     */
+    size_t getScheduledCount() const;
+
+    /**
+     * @brief Gets the thread currently allowed to consume the queue. Safe to call from any thread.
+     *
+     * @return The thread that created the queue or last collected its incoming events.
+     */
+    std::thread::id getConsumerThread() const;
+
+    /**
+     * @brief Pre-allocates room for a number of ready and scheduled events.
+     *
+     * @param capacity The number of events of each kind to make room for.
+     */
+    void reserve(size_t capacity);
+
+    /**
+     * @brief Turns coalescing on or off for an event type.
+     *
+     * @param eventType The event type.
+     * @param enabled True to merge duplicate events of the type while one is waiting.
+     */
+    void setCoalescing(EventType eventType, bool enabled);
+
+    /**
+     * @brief Gets the number of events dropped because an equal event was already waiting.
+     *
+     * @return The number of merged events since the queue was created.
+     */
+    uint64_t getMergedCount() const;
+
+    /**
+     * @brief Turns timing of the events' stay in the ready queue on or off.
+     *
+     * While on, every event is stamped with the steady clock as it is queued, which popEvent()
+     * reports. While off, no clock is read.
+     *
+     * @param enabled True to stamp events.
+     */
+    void setTiming(bool enabled);
+
+    /**
+     * @brief Reads the clock used for queue timing.
+     *
+     * @return The steady-clock time in nanoseconds.
+     */
+    static int64_t now();
+
 private:
-    std::queue<std::shared_ptr<Event>> eventQueue;  // Queue that holds events in order of priority.
+    /**
+     * @brief An event waiting in the ready heap.
+     */
+    struct ReadyEvent {
+        Event event;       // The queued event
+        uint64_t sequence; // Push order, used to keep ties first-in first-out
+        int64_t queuedAt;  // Time the event was queued (0 unless timing is on)
+    };
+
+    /**
+     * @brief Orders ready events by EventCompare, then by push order.
+     */
+    struct ReadyCompare {
+        bool operator()(const ReadyEvent& lhs, const ReadyEvent& rhs) const {
+            EventCompare compare;
+            if (compare(lhs.event, rhs.event)) {
+                return true;
+            }
+            if (compare(rhs.event, lhs.event)) {
+                return false;
+            }
+            return lhs.sequence > rhs.sequence;
+        }
+    };
+
+    /**
+     * @brief An event waiting in the scheduled heap.
+     */
+    struct ScheduledEvent {
+        Event event;       // The scheduled event
+        int64_t dueTime;   // Time at which the event becomes ready
+        uint64_t sequence; // Schedule order, used to keep ties first-in first-out
+    };
+
+    /**
+     * @brief Orders scheduled events by due time, earliest first.
+     */
+    struct ScheduledCompare {
+        bool operator()(const ScheduledEvent& lhs, const ScheduledEvent& rhs) const {
+            if (lhs.dueTime != rhs.dueTime) {
+                return lhs.dueTime > rhs.dueTime;
+            }
+            return lhs.sequence > rhs.sequence;
+        }
+    };
+
+    /**
+     * @brief An event raised on another thread, waiting in the incoming ring.
+     */
+    struct IncomingEvent {
+        Event event;      // The raised event
+        int64_t dueTime;  // Due time if the event was scheduled
+        int64_t queuedAt; // Time the event was raised (0 unless timing is on)
+        bool scheduled;   // Whether the event goes to the scheduled heap
+    };
+
+    static const size_t INCOMING_CAPACITY = 1024; // Events other threads can queue between two collections
+
+    /**
+     * @brief A merge key of a coalescing event waiting in the ready heap.
+     */
+    struct PendingKey {
+        EventType type; // Type of the waiting event
+        int source;     // Client that raised it (events from different clients never merge)
+        uint64_t key;   // Its merge key
+    };
+
+    static const size_t INITIAL_PENDING_KEYS = 64; // Merge keys reserved up front
+
+    // Adds an event to the ready heap, unless it merges into an equal waiting event
+    void pushReady(const Event& event, int64_t queuedAt);
+
+    // Reads the clock if timing is on
+    int64_t stamp() const;
+
+    // Adds an event from a thread other than the consumer
+    void pushIncoming(const IncomingEvent& incomingEvent);
+
+    // Whether the calling thread is the consumer
+    bool onConsumerThread() const;
+
+    DaryHeap<ReadyEvent, ReadyCompare> readyEvents;             // Events ready to be dispatched, highest priority on top
+    DaryHeap<ScheduledEvent, ScheduledCompare> scheduledEvents; // Events waiting for their due time, earliest on top
+    uint64_t nextSequence = 0;                                  // Sequence number for the next pushed or scheduled event
+    MpscRingBuffer<IncomingEvent> incomingEvents;               // Events raised by other threads
+    std::atomic<std::thread::id> consumerThread;                // Thread allowed to touch the heaps
+    bool coalescedTypes[EVENT_TYPE_COUNT] = {};                 // Event types whose duplicates are merged
+    std::vector<PendingKey> pendingKeys;                        // Merge keys of the waiting coalescing events
+    uint64_t mergedCount = 0;                                   // Events merged into a waiting event
+    std::atomic<bool> timing{ false };                          // Whether queued events are stamped with the clock
 };
 
 #endif // EVENT_QUEUE_H
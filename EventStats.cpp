@@ -0,0 +1,180 @@
+#include "EventStats.h"
+#include <fstream>
+#include <iostream>
+#include <cstring>
+
+namespace {
+
+// Names used in reports, indexed by EventType
+const char* const EVENT_TYPE_NAMES[] = { "COLLISION", "SPAWN", "DEATH", "INPUT", "TIMER" };
+static_assert(sizeof(EVENT_TYPE_NAMES) / sizeof(EVENT_TYPE_NAMES[0]) == EVENT_TYPE_COUNT, "Every event type needs a report name");
+
+// Position of the highest set bit of a non-zero value
+int highestBit(uint64_t value) {
+    int bit = 0;
+    for (int step = 32; step > 0; step /= 2) {
+        if (value >> step) {
+            value >>= step;
+            bit += step;
+        }
+    }
+    return bit;
+}
+
+// Write one histogram as a line of the report
+void writeHistogram(std::ostream& out, const char* label, const LatencyHistogram& histogram) {
+    out << "  " << label << " (ns): count " << histogram.getCount()
+        << ", mean " << static_cast<uint64_t>(histogram.getMean())
+        << ", min " << histogram.getMin()
+        << ", p50 " << histogram.getPercentile(50.0)
+        << ", p90 " << histogram.getPercentile(90.0)
+        << ", p99 " << histogram.getPercentile(99.0)
+        << ", p99.9 " << histogram.getPercentile(99.9)
+        << ", max " << histogram.getMax() << "\n";
+}
+
+}
+
+LatencyHistogram::LatencyHistogram() {
+    clear();
+}
+
+void LatencyHistogram::record(uint64_t value) {
+    ++counts[bucketIndex(value)];
+    ++count;
+    sum += value;
+    if (value < min) {
+        min = value;
+    }
+    if (value > max) {
+        max = value;
+    }
+}
+
+void LatencyHistogram::clear() {
+    memset(counts, 0, sizeof(counts));
+    count = 0;
+    sum = 0;
+    min = UINT64_MAX;
+    max = 0;
+}
+
+uint64_t LatencyHistogram::getCount() const {
+    return count;
+}
+
+uint64_t LatencyHistogram::getMin() const {
+    return count > 0 ? min : 0;
+}
+
+uint64_t LatencyHistogram::getMax() const {
+    return max;
+}
+
+double LatencyHistogram::getMean() const {
+    return count > 0 ? static_cast<double>(sum) / static_cast<double>(count) : 0.0;
+}
+
+uint64_t LatencyHistogram::getPercentile(double percentile) const {
+    if (count == 0) {
+        return 0;
+    }
+
+    // Rank of the value asked for, counting from 1
+    uint64_t rank = static_cast<uint64_t>(percentile / 100.0 * static_cast<double>(count) + 0.5);
+    if (rank < 1) {
+        rank = 1;
+    }
+
+    uint64_t seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; ++i) {
+        seen += counts[i];
+        if (seen >= rank) {
+            uint64_t lowerBound = bucketLowerBound(i);
+            return lowerBound > min ? lowerBound : min;
+        }
+    }
+    return max;
+}
+
+int LatencyHistogram::bucketIndex(uint64_t value) {
+    if (value < static_cast<uint64_t>(SUB_BUCKETS)) {
+        return static_cast<int>(value);  // Small values get a bucket each
+    }
+
+    // The power of two picks the group; the bits just below the top bit pick the bucket within it
+    int bit = highestBit(value);
+    int subBucket = static_cast<int>((value >> (bit - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1));
+    return (bit - SUB_BUCKET_BITS + 1) * SUB_BUCKETS + subBucket;
+}
+
+uint64_t LatencyHistogram::bucketLowerBound(int index) {
+    if (index < SUB_BUCKETS) {
+        return static_cast<uint64_t>(index);
+    }
+    int bit = index / SUB_BUCKETS + SUB_BUCKET_BITS - 1;
+    uint64_t subBucket = static_cast<uint64_t>(index % SUB_BUCKETS);
+    return (uint64_t(1) << bit) | (subBucket << (bit - SUB_BUCKET_BITS));
+}
+
+EventStats::EventStats() {
+    clear();
+}
+
+void EventStats::recordRaised(EventType eventType) {
+    raisedCounts[eventType].fetch_add(1, std::memory_order_relaxed);
+}
+
+void EventStats::recordDispatched(EventType eventType) {
+    ++dispatchedCounts[eventType];
+}
+
+void EventStats::recordQueueLatency(EventType eventType, uint64_t queueLatency) {
+    queueLatencies[eventType].record(queueLatency);
+}
+
+void EventStats::recordHandler(EventType eventType, uint64_t handlerTime) {
+    handlerTimes[eventType].record(handlerTime);
+}
+
+void EventStats::clear() {
+    for (int i = 0; i < EVENT_TYPE_COUNT; ++i) {
+        raisedCounts[i].store(0, std::memory_order_relaxed);
+        dispatchedCounts[i] = 0;
+        queueLatencies[i].clear();
+        handlerTimes[i].clear();
+    }
+}
+
+uint64_t EventStats::getRaisedCount(EventType eventType) const {
+    return raisedCounts[eventType].load(std::memory_order_relaxed);
+}
+
+uint64_t EventStats::getDispatchedCount(EventType eventType) const {
+    return dispatchedCounts[eventType];
+}
+
+const LatencyHistogram& EventStats::getQueueLatency(EventType eventType) const {
+    return queueLatencies[eventType];
+}
+
+const LatencyHistogram& EventStats::getHandlerTime(EventType eventType) const {
+    return handlerTimes[eventType];
+}
+
+bool EventStats::writeReport(const std::string& path) const {
+    std::ofstream file(path, std::ios::trunc);
+    if (!file) {
+        std::cerr << "Failed to open event stats report for writing: " << path << std::endl;
+        return false;
+    }
+
+    for (int i = 0; i < EVENT_TYPE_COUNT; ++i) {
+        EventType eventType = static_cast<EventType>(i);
+        file << EVENT_TYPE_NAMES[i] << ": raised " << getRaisedCount(eventType)
+            << ", dispatched " << getDispatchedCount(eventType) << "\n";
+        writeHistogram(file, "queue latency", queueLatencies[i]);
+        writeHistogram(file, "handler time", handlerTimes[i]);
+    }
+    return static_cast<bool>(file);
+}
@@ -0,0 +1,158 @@
+#ifndef EVENT_STATS_H
+#define EVENT_STATS_H
+
+#include <atomic>
+#include <string>
+#include <cstdint>
+#include "Event.h"
+
+/**
+ * @brief A fixed-size histogram of durations with bounded relative error.
+ *
+ * Values are counted in log-linear buckets, as in HDR histograms: every power of two is split
+ * into SUB_BUCKETS equal buckets, so a bucket is never wider than 1/SUB_BUCKETS of its lower
+ * bound. Recording a value is a few shifts and an increment, and the whole histogram is one flat
+ * array, so it can sit on the dispatch path without allocating.
+ */
+class LatencyHistogram {
+public:
+    static const int SUB_BUCKET_BITS = 5;                   // log2 of the buckets per power of two
+    static const int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;    // Buckets per power of two (about 3% precision)
+    static const int BUCKET_COUNT = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS; // Enough buckets for any uint64_t
+
+    LatencyHistogram();
+
+    /**
+     * @brief Count one value.
+     * @param value The value, in nanoseconds.
+     */
+    void record(uint64_t value);
+
+    /**
+     * @brief Remove every recorded value.
+     */
+    void clear();
+
+    /**
+     * @brief Get the number of recorded values.
+     * @return The count.
+     */
+    uint64_t getCount() const;
+
+    /**
+     * @brief Get the smallest recorded value.
+     * @return The minimum, or 0 if nothing was recorded.
+     */
+    uint64_t getMin() const;
+
+    /**
+     * @brief Get the largest recorded value.
+     * @return The maximum, or 0 if nothing was recorded.
+     */
+    uint64_t getMax() const;
+
+    /**
+     * @brief Get the mean of the recorded values.
+     * @return The mean, or 0 if nothing was recorded.
+     */
+    double getMean() const;
+
+    /**
+     * @brief Get the value below which a given share of the recorded values fall.
+     * @param percentile The share, from 0 to 100.
+     * @return The lower bound of the bucket holding that value (within about 3% of it), or 0 if nothing was recorded.
+     */
+    uint64_t getPercentile(double percentile) const;
+
+private:
+    // Index of the bucket that counts a value
+    static int bucketIndex(uint64_t value);
+
+    // Smallest value counted by a bucket
+    static uint64_t bucketLowerBound(int index);
+
+    uint64_t counts[BUCKET_COUNT]; // Values per bucket
+    uint64_t count;                // Number of recorded values
+    uint64_t sum;                  // Sum of the recorded values, for the mean
+    uint64_t min;                  // Smallest recorded value
+    uint64_t max;                  // Largest recorded value
+};
+
+/**
+ * @brief Event counters and latency histograms for one EventManager, per event type.
+ *
+ * Tracks how many events of each type were raised and dispatched, how long they waited in the
+ * queue before dispatch, and how long each handler invocation took. Raise counts may be updated
+ * from any thread; everything else is recorded on the dispatching thread and should be read there.
+ */
+class EventStats {
+public:
+    EventStats();
+
+    EventStats(const EventStats&) = delete;
+    EventStats& operator=(const EventStats&) = delete;
+
+    /**
+     * @brief Count a raised event. Safe to call from any thread.
+     * @param eventType The type of the event.
+     */
+    void recordRaised(EventType eventType);
+
+    /**
+     * @brief Count a dispatched event.
+     * @param eventType The type of the event.
+     */
+    void recordDispatched(EventType eventType);
+
+    /**
+     * @brief Record the time a dispatched event spent queued. Events queued while stats were off
+     *        carry no queue time and are counted without a sample.
+     * @param eventType The type of the event.
+     * @param queueLatency Nanoseconds from entering the ready queue to being dispatched.
+     */
+    void recordQueueLatency(EventType eventType, uint64_t queueLatency);
+
+    /**
+     * @brief Count one handler invocation and its running time.
+     * @param eventType The type of the event the handler ran for.
+     * @param handlerTime Nanoseconds the handler ran for.
+     */
+    void recordHandler(EventType eventType, uint64_t handlerTime);
+
+    /**
+     * @brief Reset every counter and histogram.
+     */
+    void clear();
+
+    uint64_t getRaisedCount(EventType eventType) const;
+    uint64_t getDispatchedCount(EventType eventType) const;
+
+    /**
+     * @brief Accessor for the queue latency histogram of an event type.
+     * @param eventType The event type.
+     * @return Nanoseconds between entering the ready queue and being dispatched.
+     */
+    const LatencyHistogram& getQueueLatency(EventType eventType) const;
+
+    /**
+     * @brief Accessor for the handler time histogram of an event type.
+     * @param eventType The event type.
+     * @return Nanoseconds per handler invocation.
+     */
+    const LatencyHistogram& getHandlerTime(EventType eventType) const;
+
+    /**
+     * @brief Write a plain-text report of every counter and histogram.
+     * @param path The file to write.
+     * @return True if the report was written, false otherwise.
+     */
+    bool writeReport(const std::string& path) const;
+
+private:
+    std::atomic<uint64_t> raisedCounts[EVENT_TYPE_COUNT]; // Raised events per type
+    uint64_t dispatchedCounts[EVENT_TYPE_COUNT];          // Dispatched events per type
+    LatencyHistogram queueLatencies[EVENT_TYPE_COUNT];    // Queue latency per type
+    LatencyHistogram handlerTimes[EVENT_TYPE_COUNT];      // Handler running time per type
+};
+
+#endif // EVENT_STATS_H
@@ -1,12 +1,25 @@
 #include "InputEvent.h"
 
+static_assert(sizeof(InputEvent) == sizeof(Event), "InputEvent keeps its data in the event payload");
+
+// Packs the input into the inline payload
+static EventPayload makeInputPayload(int objectID, InputAction inputAction) {
+    EventPayload payload = {};
+    payload.input.objectID = objectID;
+    payload.input.inputAction = inputAction;
+    return payload;
+}
+
 InputEvent::InputEvent(int objectID, const InputAction& inputAction, Timeline* timeline)
-    : Event(INPUT, 4, timeline), objectID(objectID), inputAction(inputAction) {}
+    : Event(INPUT, 4, timeline, makeInputPayload(objectID, inputAction)) {}
+
+InputEvent::InputEvent(const Event& event)
+    : Event(event) {}
 
 int InputEvent::getObjectID() const {
-    return objectID;
+    return getPayload().input.objectID;
 }
 
 InputAction InputEvent::getInputAction() const {
-    return inputAction;
+    return static_cast<InputAction>(getPayload().input.inputAction);
 }
\ No newline at end of file
@@ -36,6 +36,13 @@ public:
      */
     InputEvent(int objectID, const InputAction& inputAction, Timeline* timeline);
 
+    /**
+     * @brief Views a dispatched event as a InputEvent.
+     *
+     * @param event An event whose type is INPUT.
+     */
+    explicit InputEvent(const Event& event);
+
     /**
      * @brief Retrieves the ID of the object associated with this input event.
      *
@@ -49,10 +56,6 @@ public:
      * @return The InputAction representing the player's action.
      */
     InputAction getInputAction() const;
-
-private:
-    int objectID;            // ID of the object receiving the input.
-    InputAction inputAction; // Type of input action (e.g., MOVE_LEFT, JUMP).
 };
 
 #endif // INPUT_EVENT_H
@@ -0,0 +1,124 @@
+#ifndef MPSC_RING_BUFFER_H
+#define MPSC_RING_BUFFER_H
+
+#include <atomic>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+/**
+ * @brief A bounded, lock-free queue for many producer threads and a single consumer thread.
+ *
+ * Each cell carries a sequence number that tells producers and the consumer whether the cell is
+ * free or filled for the current lap around the ring (Vyukov's bounded queue). Producers claim a
+ * cell with one compare-and-swap on the shared tail and publish it with a release store; the
+ * consumer never writes shared counters other than the cell it just emptied. No thread ever
+ * waits on a lock, and a full ring is reported to the producer instead of blocking it.
+ *
+ * Only trivially copyable values are supported, so cells can hold raw storage.
+ */
+template <typename T>
+class MpscRingBuffer {
+public:
+    static_assert(std::is_trivially_copyable<T>::value, "MpscRingBuffer values must be trivially copyable");
+
+    /**
+     * @brief Construct an empty ring.
+     * @param capacity The maximum number of queued values, rounded up to a power of two.
+     */
+    explicit MpscRingBuffer(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity) {
+            size *= 2;
+        }
+        mask = size - 1;
+        cells.reset(new Cell[size]);
+        for (size_t i = 0; i < size; ++i) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscRingBuffer(const MpscRingBuffer&) = delete;
+    MpscRingBuffer& operator=(const MpscRingBuffer&) = delete;
+
+    /**
+     * @brief Add a value from any thread.
+     * @param value The value to add.
+     * @return True if the value was queued, false if the ring is full.
+     */
+    bool tryPush(const T& value) {
+        size_t position = tail.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &cells[position & mask];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+            if (difference == 0) {
+                // The cell is free for this lap; try to claim it
+                if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            }
+            else if (difference < 0) {
+                return false;  // The consumer has not emptied this cell yet, so the ring is full
+            }
+            else {
+                position = tail.load(std::memory_order_relaxed);  // Another producer claimed it
+            }
+        }
+
+        new (&cell->storage) T(value);
+        cell->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Remove the oldest value. Must only be called from the consumer thread.
+     * @param value Receives the removed value.
+     * @return True if a value was removed, false if the ring is empty.
+     */
+    bool tryPop(T& value) {
+        Cell& cell = cells[head & mask];
+        size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        if (sequence != head + 1) {
+            return false;  // Not published yet
+        }
+
+        value = *reinterpret_cast<const T*>(&cell.storage);
+        cell.sequence.store(head + mask + 1, std::memory_order_release);
+        ++head;
+        return true;
+    }
+
+    /**
+     * @brief Get the maximum number of queued values.
+     * @return The capacity of the ring.
+     */
+    size_t capacity() const {
+        return mask + 1;
+    }
+
+private:
+    static const size_t CACHE_LINE_SIZE = 64;
+
+    /**
+     * @brief One slot of the ring.
+     */
+    struct Cell {
+        std::atomic<size_t> sequence;                                       // Lap marker for this cell
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage; // The queued value
+    };
+
+    std::unique_ptr<Cell[]> cells; // The ring itself
+    size_t mask;                   // Capacity - 1, for wrapping positions
+
+    // Keep the producers' counter and the consumer's counter on separate cache lines
+    char padding1[CACHE_LINE_SIZE];
+    std::atomic<size_t> tail{ 0 }; // Next position producers will claim
+    char padding2[CACHE_LINE_SIZE];
+    size_t head = 0;               // Next position the consumer will read
+};
+
+#endif // MPSC_RING_BUFFER_H
@@ -0,0 +1,108 @@
+#include "NetworkEventBus.h"
+#include "EventJournal.h"
+#include <iostream>
+#include <cstring>
+
+// Connect to the server's event relay
+NetworkEventBus::NetworkEventBus(EventManager& eventManager, zmq::context_t& context,
+    const std::string& pushEndpoint, const std::string& subEndpoint)
+    : eventManager(eventManager), pushSocket(context, zmq::socket_type::push), subSocket(context, zmq::socket_type::sub) {
+    // Unsent batches are worthless once the game exits
+    pushSocket.set(zmq::sockopt::linger, 0);
+    pushSocket.connect(pushEndpoint);
+    subSocket.connect(subEndpoint);
+    subSocket.set(zmq::sockopt::subscribe, "");
+}
+
+// Set the ID the server assigned to this client
+void NetworkEventBus::setClientId(int clientId) {
+    this->clientId = clientId;
+}
+
+// Send the replicated events dispatched since the last call as one batch
+size_t NetworkEventBus::send() {
+    eventManager.takeReplicatedEvents(outgoing);
+    if (outgoing.empty() || clientId == -1) {
+        return 0;
+    }
+
+    BatchHeader header = { MAGIC, static_cast<uint32_t>(sizeof(EventJournalRecord)), clientId, static_cast<uint32_t>(outgoing.size()) };
+    zmq::message_t batch(sizeof(header) + outgoing.size() * sizeof(EventJournalRecord));
+    char* buffer = static_cast<char*>(batch.data());
+    memcpy(buffer, &header, sizeof(header));
+    buffer += sizeof(header);
+    for (const Event& event : outgoing) {
+        EventJournalRecord record = EventJournal::toRecord(event);
+        memcpy(buffer, &record, sizeof(record));
+        buffer += sizeof(record);
+    }
+
+    // Batches keep failing every tick while the relay is down, so only changes of state are logged
+    try {
+        if (!pushSocket.send(batch, zmq::send_flags::dontwait)) {
+            if (relayReachable) {
+                std::cerr << "Event relay is not keeping up; dropping events until it does" << std::endl;
+                relayReachable = false;
+            }
+            return 0;
+        }
+    }
+    catch (const zmq::error_t& e) {
+        if (relayReachable) {
+            std::cerr << "Error sending events: " << e.what() << std::endl;
+            relayReachable = false;
+        }
+        return 0;
+    }
+    if (!relayReachable) {
+        std::cerr << "Event relay reachable again" << std::endl;
+        relayReachable = true;
+    }
+    return outgoing.size();
+}
+
+// Raise the events of every batch other clients have published
+size_t NetworkEventBus::receive() {
+    size_t raised = 0;
+    zmq::message_t batch;
+    while (true) {
+        try {
+            if (!subSocket.recv(batch, zmq::recv_flags::dontwait)) {
+                break;  // Nothing more has arrived
+            }
+        }
+        catch (const zmq::error_t& e) {
+            std::cerr << "Error receiving events: " << e.what() << std::endl;
+            break;
+        }
+
+        BatchHeader header;
+        if (batch.size() < sizeof(header)) {
+            continue;
+        }
+        memcpy(&header, batch.data(), sizeof(header));
+        if (header.magic != MAGIC || header.recordSize != sizeof(EventJournalRecord)
+            || batch.size() != sizeof(header) + header.count * sizeof(EventJournalRecord)) {
+            std::cerr << "Ignoring incompatible event batch" << std::endl;
+            continue;
+        }
+        if (header.sourceClient == clientId) {
+            continue;  // The relay publishes this client's own batches back to it
+        }
+
+        const char* buffer = static_cast<const char*>(batch.data()) + sizeof(header);
+        for (uint32_t i = 0; i < header.count; ++i) {
+            EventJournalRecord record;
+            memcpy(&record, buffer + i * sizeof(record), sizeof(record));
+            if (record.type < 0 || record.type >= EVENT_TYPE_COUNT) {
+                continue;
+            }
+
+            Event event = EventJournal::fromRecord(record);
+            event.setSource(header.sourceClient);
+            eventManager.raiseEvent(event);
+            ++raised;
+        }
+    }
+    return raised;
+}
@@ -0,0 +1,84 @@
+#ifndef NETWORK_EVENT_BUS_H
+#define NETWORK_EVENT_BUS_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <zmq.hpp>
+#include "EventManager.h"
+
+// Endpoints of the server's event relay: clients push batches to the first and receive every client's batches from the second
+#define EVENT_RELAY_PUSH_ENDPOINT "tcp://localhost:5558"
+#define EVENT_RELAY_SUB_ENDPOINT "tcp://localhost:5559"
+
+/**
+ * @brief Shares the replicated event types of an EventManager with the other clients.
+ *
+ * Once per tick, send() packs every replicated event dispatched since the previous tick into one
+ * message and pushes it to the server, which publishes it to every client. receive() takes the
+ * batches other clients published and raises their events locally, marked with the sending
+ * client's ID so they only reach remote handlers (see EventManager::subscribeRemote()). Neither
+ * call ever waits for the server, so a slow or missing server costs the game loop nothing.
+ *
+ * A batch is a BatchHeader followed by one EventJournalRecord per event, the same fixed-size
+ * record the event journal uses, so clients must run builds with the same event layout.
+ */
+class NetworkEventBus {
+public:
+    static const uint32_t MAGIC = 0x54425645; // "EVBT" in wire byte order on little-endian machines
+
+    /**
+     * @brief Connects to the server's event relay.
+     * @param eventManager The manager whose replicated events are sent and which receives remote events.
+     * @param context The ZeroMQ context to create the sockets in.
+     * @param pushEndpoint Endpoint the batches are pushed to.
+     * @param subEndpoint Endpoint the batches of every client are published on.
+     */
+    NetworkEventBus(EventManager& eventManager, zmq::context_t& context,
+        const std::string& pushEndpoint = EVENT_RELAY_PUSH_ENDPOINT, const std::string& subEndpoint = EVENT_RELAY_SUB_ENDPOINT);
+
+    NetworkEventBus(const NetworkEventBus&) = delete;
+    NetworkEventBus& operator=(const NetworkEventBus&) = delete;
+
+    /**
+     * @brief Sets the ID the server assigned to this client.
+     *
+     * Nothing is sent until the ID is known, since other clients could not tell this client's
+     * batches apart from their own.
+     *
+     * @param clientId The client ID.
+     */
+    void setClientId(int clientId);
+
+    /**
+     * @brief Sends the replicated events dispatched since the last call as one batch.
+     * @return The number of events sent.
+     */
+    size_t send();
+
+    /**
+     * @brief Raises the events of every batch other clients have published since the last call.
+     * @return The number of events raised.
+     */
+    size_t receive();
+
+private:
+    /**
+     * @brief Fixed header at the start of every batch.
+     */
+    struct BatchHeader {
+        uint32_t magic;        // NetworkEventBus::MAGIC
+        uint32_t recordSize;   // Size of one record, used to reject mismatched builds
+        int32_t sourceClient;  // Client that raised the events
+        uint32_t count;        // Number of records that follow
+    };
+
+    EventManager& eventManager;  // Manager the events come from and go to
+    zmq::socket_t pushSocket;    // Sends this client's batches to the relay
+    zmq::socket_t subSocket;     // Receives every client's batches from the relay
+    int clientId = -1;           // ID assigned by the server, or -1 until it is known
+    bool relayReachable = true;  // Whether the last batch reached the relay; failures are logged once per change
+    std::vector<Event> outgoing; // Events of the batch being sent (reused every tick)
+};
+
+#endif // NETWORK_EVENT_BUS_H
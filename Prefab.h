@@ -0,0 +1,89 @@
+#ifndef PREFAB_H
+#define PREFAB_H
+
+#include <vector>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include "Property.h"
+#include "ComponentStorage.h"
+
+/**
+ * @brief A reusable bundle of property values used to create many identical objects at once.
+ *
+ * Define the bundle once with set(), then pass it to PropertyManager::instantiate() to create any
+ * number of copies. Instantiation appends every copy of a property type to its storage in a single
+ * batch, so spawning a wave or rebuilding a level costs one bulk fill per property type instead of
+ * one insert per object and property. Per-object differences (such as positions) can be written
+ * through getProperty() afterwards.
+ */
+class Prefab {
+public:
+    /**
+     * @brief One property value in the bundle.
+     */
+    struct Entry {
+        PropertyType propertyType;            // Type of the property
+        size_t offset;                        // Offset of the property value in the payload buffer
+        IComponentStorage* (*createStorage)(); // Creates the storage for propertyType if it does not exist yet
+    };
+
+    /**
+     * @brief Add a property to the bundle, replacing any existing value of the same type.
+     * @param property The property value every instance starts with.
+     * @return This prefab, so calls can be chained.
+     */
+    template <typename T>
+    Prefab& set(const T& property) {
+        static_assert(std::is_trivially_copyable<T>::value, "Prefab properties must be trivially copyable");
+
+        for (const Entry& entry : entries) {
+            if (entry.propertyType == T::TYPE) {
+                std::memcpy(&payload[entry.offset], &property, sizeof(T));
+                return *this;
+            }
+        }
+
+        // Keep every payload aligned so it can be read back in place
+        const size_t alignment = alignof(std::max_align_t);
+        size_t offset = (payload.size() + alignment - 1) / alignment * alignment;
+        payload.resize(offset + sizeof(T));
+        std::memcpy(&payload[offset], &property, sizeof(T));
+
+        entries.push_back({ T::TYPE, offset, &createComponentStorage<T> });
+        signature |= makeSignature<T>();
+        return *this;
+    }
+
+    /**
+     * @brief Accessor for the property values in the bundle.
+     * @return The entries, in the order they were first set.
+     */
+    const std::vector<Entry>& getEntries() const {
+        return entries;
+    }
+
+    /**
+     * @brief Get the stored value of an entry.
+     * @param entry The entry.
+     * @return A pointer to the property value.
+     */
+    const void* getPayload(const Entry& entry) const {
+        return &payload[entry.offset];
+    }
+
+    /**
+     * @brief Get the signature of the property types in the bundle.
+     * @return The signature every instance starts with.
+     */
+    PropertySignature getSignature() const {
+        return signature;
+    }
+
+private:
+    std::vector<Entry> entries;         // Property types in the bundle
+    std::vector<unsigned char> payload; // Property values
+    PropertySignature signature = 0;    // Property types in the bundle as a signature
+};
+
+#endif // PREFAB_H
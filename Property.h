@@ -1,22 +1,54 @@
 #ifndef PROPERTY_H
 #define PROPERTY_H
 
-#include <string>
 #include "SDL2/SDL.h"
+#include <cstdint>
 
 /**
- * @brief The base class for all properties.
+ * @brief Compile-time type IDs for every property type.
+ *
+ * Each property class exposes its ID as a static TYPE constant, which the PropertyManager uses
+ * to index its per-type storage without any runtime lookup.
  */
-class Property {
-public:
-	virtual ~Property() {}  // Virtual destructor for proper cleanup
+enum PropertyType {
+	RECT_PROPERTY,      // RectProperty
+	RENDER_PROPERTY,    // RenderProperty
+	PHYSICS_PROPERTY,   // PhysicsProperty
+	COLLISION_PROPERTY, // CollisionProperty
+	VELOCITY_PROPERTY,  // VelocityProperty
+	INPUT_PROPERTY,     // InputProperty
+	SCROLLING_PROPERTY, // ScrollingProperty
+	PROPERTY_TYPE_COUNT // Number of property types (not a property type itself)
+};
 
-	/**
-  * @brief Get the type of the property.
-  * @return The type of the property as a string.
-  */
-	virtual std::string getType() const = 0;
+/**
+ * @brief A bitmask with one bit per PropertyType, recording which property types an object has.
+ */
+typedef uint32_t PropertySignature;
+
+static_assert(PROPERTY_TYPE_COUNT <= 32, "PropertySignature needs one bit per property type");
+
+/**
+ * @brief Build the signature made of the given property types.
+ * @return A signature with the bit of every listed type set.
+ */
+template <typename... Ts>
+PropertySignature makeSignature() {
+	PropertySignature bits[] = { 0u, (PropertySignature(1) << Ts::TYPE)... };
+	PropertySignature signature = 0;
+	for (PropertySignature bit : bits) {
+		signature |= bit;
+	}
+	return signature;
+}
 
+/**
+ * @brief The base class for all properties.
+ *
+ * Properties are plain values stored in dense per-type arrays, so the base class carries no
+ * virtual functions. The type of a property is known at compile time through its TYPE constant.
+ */
+class Property {
 };
 
 /**
@@ -34,9 +66,7 @@ public:
   */
 	RectProperty(int x, int y, int w, int h) : x(x), y(y), w(w), h(h) {}
 
-	std::string getType() const override {
-		return "Rect";
-	}
+	static constexpr PropertyType TYPE = RECT_PROPERTY; /**< Compile-time type ID of the property. */
 
 	int x; /**< The x-coordinate of the rectangle. */
 	int y; /**< The y-coordinate of the rectangle. */
@@ -59,9 +89,7 @@ public:
   */
 	RenderProperty(int r, int g, int b) : r(r), g(g), b(b) {}
 
-	std::string getType() const override {
-		return "Render";
-	}
+	static constexpr PropertyType TYPE = RENDER_PROPERTY; /**< Compile-time type ID of the property. */
 
 	int r; /**< The red component of the color. */
 	int g; /**< The green component of the color. */
@@ -81,9 +109,7 @@ public:
   */
 	PhysicsProperty(int gravity) : gravity(gravity) {}
 
-	std::string getType() const override {
-		return "Physics";
-	}
+	static constexpr PropertyType TYPE = PHYSICS_PROPERTY; /**< Compile-time type ID of the property. */
 
 	int gravity; /**< The gravity value. */
 
@@ -101,9 +127,7 @@ public:
   */
 	CollisionProperty(bool hasCollision) : hasCollision(hasCollision) {}
 
-	std::string getType() const override {
-		return "Collision";
-	}
+	static constexpr PropertyType TYPE = COLLISION_PROPERTY; /**< Compile-time type ID of the property. */
 
 	bool hasCollision; /**< Whether the object has collision or not. */
 
@@ -122,9 +146,7 @@ public:
   */
 	VelocityProperty(int vx, int vy) : vx(vx), vy(vy) {}
 
-	std::string getType() const override {
-		return "Velocity";
-	}
+	static constexpr PropertyType TYPE = VELOCITY_PROPERTY; /**< Compile-time type ID of the property. */
 
 	int vx; /**< The velocity in the x-axis. */
 	int vy; /**< The velocity in the y-axis. */
@@ -143,9 +165,7 @@ public:
   */
 	InputProperty(bool hasInput, bool isJumping) : hasInput(hasInput), isJumping(isJumping) {}
 
-	std::string getType() const override {
-		return "Input";
-	}
+	static constexpr PropertyType TYPE = INPUT_PROPERTY; /**< Compile-time type ID of the property. */
 
 	bool hasInput; /**< Whether the object has input or not. */
 	bool isJumping; /**< Whether the object is jumping or not. */
@@ -164,9 +184,7 @@ public:
   */
 	ScrollingProperty(bool scrolls) : scrolls(scrolls) {}
 
-	std::string getType() const override {
-		return "Scrolling";
-	}
+	static constexpr PropertyType TYPE = SCROLLING_PROPERTY; /**< Compile-time type ID of the property. */
 
 	bool scrolls; /**< Whether the object scrolls or not. */
 
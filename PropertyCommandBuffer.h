@@ -0,0 +1,131 @@
+#ifndef PROPERTY_COMMAND_BUFFER_H
+#define PROPERTY_COMMAND_BUFFER_H
+
+#include <vector>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include "Property.h"
+#include "ComponentStorage.h"
+#include "Entity.h"
+
+/**
+ * @brief Records object creation, property addition and object destruction for later playback.
+ *
+ * Systems that iterate storages or views cannot safely change them mid-walk. Instead they record
+ * structural changes into a command buffer, and PropertyManager::playback() applies all of them
+ * at a single sync point. Objects created through the buffer get a temporary (negative) ID that
+ * can be used with addProperty/destroyObject on the same buffer and is resolved to a real
+ * object ID during playback.
+ *
+ * The buffer keeps its memory between frames, so steady-state recording does not allocate.
+ */
+class PropertyCommandBuffer {
+public:
+    /**
+     * @brief The kind of structural change a command performs.
+     */
+    enum CommandType {
+        CREATE_OBJECT,  // Create a new object for a temporary ID
+        ADD_PROPERTY,   // Add (or replace) a property on an object
+        DESTROY_OBJECT  // Destroy an object and all its properties
+    };
+
+    /**
+     * @brief A single recorded command.
+     */
+    struct Command {
+        CommandType type;                     // What the command does
+        int objectID;                         // Target object (real or temporary ID)
+        PropertyType propertyType;            // Property type for ADD_PROPERTY
+        size_t offset;                        // Offset of the property value in the payload buffer
+        IComponentStorage* (*createStorage)(); // Creates the storage for propertyType if it does not exist yet
+    };
+
+    /**
+     * @brief Record the creation of a new object.
+     * @return A temporary ID that is valid only within this buffer until playback.
+     */
+    int createObject() {
+        int temporaryID = -(pendingCreates + 2);  // -1 is Entity::INVALID_ID, so start at -2
+        ++pendingCreates;
+        commands.push_back({ CREATE_OBJECT, temporaryID, PROPERTY_TYPE_COUNT, 0, nullptr });
+        return temporaryID;
+    }
+
+    /**
+     * @brief Record adding a property to an object.
+     * @param objectID The ID of the object (real, or temporary from createObject()).
+     * @param property The property value to add.
+     */
+    template <typename T>
+    void addProperty(int objectID, const T& property) {
+        static_assert(std::is_trivially_copyable<T>::value, "Deferred properties must be trivially copyable");
+
+        // Keep every payload aligned so it can be read back in place
+        const size_t alignment = alignof(std::max_align_t);
+        size_t offset = (payload.size() + alignment - 1) / alignment * alignment;
+        payload.resize(offset + sizeof(T));
+        std::memcpy(&payload[offset], &property, sizeof(T));
+
+        commands.push_back({ ADD_PROPERTY, objectID, T::TYPE, offset, &createComponentStorage<T> });
+    }
+
+    /**
+     * @brief Record the destruction of an object.
+     * @param objectID The ID of the object (real, or temporary from createObject()).
+     */
+    void destroyObject(int objectID) {
+        commands.push_back({ DESTROY_OBJECT, objectID, PROPERTY_TYPE_COUNT, 0, nullptr });
+    }
+
+    /**
+     * @brief Check whether any commands are waiting for playback.
+     * @return True if the buffer is empty, false otherwise.
+     */
+    bool isEmpty() const {
+        return commands.empty();
+    }
+
+    /**
+     * @brief Discard all recorded commands while keeping the allocated memory.
+     */
+    void clear() {
+        commands.clear();
+        payload.clear();
+        pendingCreates = 0;
+    }
+
+    /**
+     * @brief Accessor for the recorded commands, in recording order.
+     * @return The recorded commands.
+     */
+    const std::vector<Command>& getCommands() const {
+        return commands;
+    }
+
+    /**
+     * @brief Get the stored value of an ADD_PROPERTY command.
+     * @param command The command.
+     * @return A pointer to the property value.
+     */
+    const void* getPayload(const Command& command) const {
+        return &payload[command.offset];
+    }
+
+    /**
+     * @brief Get the slot used for a temporary ID when resolving it during playback.
+     * @param temporaryID A temporary ID returned by createObject().
+     * @return The zero-based index of the creation command.
+     */
+    static int getTemporaryIndex(int temporaryID) {
+        return -temporaryID - 2;
+    }
+
+private:
+    std::vector<Command> commands;      // Recorded commands, in order
+    std::vector<unsigned char> payload; // Property values for ADD_PROPERTY commands
+    int pendingCreates = 0;             // Number of CREATE_OBJECT commands recorded
+};
+
+#endif // PROPERTY_COMMAND_BUFFER_H
@@ -1,91 +1,430 @@
 #ifndef PROPERTY_MANAGER_H
 #define PROPERTY_MANAGER_H
 
-#include <unordered_map>
-#include <string>
+#include <array>
+#include <algorithm>
+#include <vector>
 #include <memory>
+#include <cstdint>
+#include <type_traits>
 #include "Property.h"
+#include "ComponentStorage.h"
+#include "PropertyView.h"
+#include "PropertyCommandBuffer.h"
+#include "Prefab.h"
+#include "Entity.h"
 
 /**
  * @brief The PropertyManager class is responsible for managing properties of game objects.
+ *
+ * Properties are stored by value in one ComponentStorage per type, under generational object IDs.
  */
 class PropertyManager {
 public:
+    PropertyManager() = default;
+    ~PropertyManager() = default;
+
+    // Prevent copy constructor and assignment
+    PropertyManager(const PropertyManager&) = delete;
+    PropertyManager& operator=(const PropertyManager&) = delete;
+
     /**
-     * @brief Get the singleton instance of PropertyManager.
-     * @return The singleton instance of PropertyManager.
+     * @brief Add a property to an object, replacing any existing property of the same type.
+     * @param objectID The ID of the object.
+     * @param property The property to add.
+     * @return A pointer to the stored property, or nullptr if the object does not exist.
      */
-    static PropertyManager& getInstance() {
-        static PropertyManager instance;
-        return instance;
+    template <typename T>
+    T* addProperty(int objectID, const T& property) {
+        if (!hasObject(objectID)) {
+            return nullptr;
+        }
+        signatures[Entity::getIndex(objectID)] |= makeSignature<T>();
+        return &getStorage<T>().insert(objectID, property, changeVersion);
     }
 
     /**
-     * @brief Add a property to an object by its ID and property type.
+     * @brief Get a property of the given type from an object.
      * @param objectID The ID of the object.
-     * @param key The key of the property.
-     * @param property The property to add.
+     * @return A pointer to the property if found, nullptr otherwise.
      */
-    void addProperty(int objectID, const std::string& key, std::shared_ptr<Property> property) {
-        properties[objectID][key] = property;
+    template <typename T>
+    T* getProperty(int objectID) {
+        return getStorage<T>().get(objectID);
     }
 
     /**
-     * @brief Get a property from an object by its ID and property type.
+     * @brief Check if an object has a property of the given type.
      * @param objectID The ID of the object.
-     * @param key The key of the property.
-     * @return The property if found, nullptr otherwise.
+     * @return True if the object has the property, false otherwise.
      */
-    std::shared_ptr<Property> getProperty(int objectID, const std::string& key) {
-        if (properties.count(objectID) && properties[objectID].count(key)) {
-            return properties[objectID][key];
+    template <typename T>
+    bool hasProperty(int objectID) const {
+        return hasProperties<T>(objectID);
+    }
+
+    /**
+     * @brief Check if an object has every one of the given property types.
+     * @param objectID The ID of the object.
+     * @return True if the object exists and has all the properties, false otherwise.
+     */
+    template <typename... Ts>
+    bool hasProperties(int objectID) const {
+        PropertySignature required = makeSignature<Ts...>();
+        return hasObject(objectID) && (signatures[Entity::getIndex(objectID)] & required) == required;
+    }
+
+    /**
+     * @brief Get the signature of the property types an object holds.
+     * @param objectID The ID of the object.
+     * @return The object's signature, or 0 if the object does not exist.
+     */
+    PropertySignature getSignature(int objectID) const {
+        return hasObject(objectID) ? signatures[Entity::getIndex(objectID)] : 0;
+    }
+
+    /**
+     * @brief Accessor for the signature of every object slot, indexed by slot index.
+     *
+     * Destroyed and unused slots have an empty signature, so a linear scan of this array with
+     * (signature & required) == required finds every object that has a set of property types.
+     *
+     * @return The signatures.
+     */
+    const std::vector<PropertySignature>& getSignatures() const {
+        return signatures;
+    }
+
+    /**
+     * @brief Record that an object's property was modified.
+     *
+     * Call this after writing through the pointer returned by getProperty() so change queries see
+     * the update.
+     *
+     * @param objectID The ID of the object.
+     */
+    template <typename T>
+    void markChanged(int objectID) {
+        getStorage<T>().markChanged(objectID, changeVersion);
+    }
+
+    /**
+     * @brief Check whether an object's property changed after a captured version.
+     * @param objectID The ID of the object.
+     * @param version A version previously returned by captureVersion().
+     * @return True if the property was added or marked changed since the version, false otherwise.
+     */
+    template <typename T>
+    bool hasChangedSince(int objectID, uint32_t version) {
+        return getStorage<T>().getVersion(objectID) > version;
+    }
+
+    /**
+     * @brief Collect every object whose property of the given type changed after a captured version.
+     * @param version A version previously returned by captureVersion().
+     * @param changedIDs Receives the IDs of the changed objects (cleared first).
+     */
+    template <typename T>
+    void getChangedSince(uint32_t version, std::vector<int>& changedIDs) {
+        ComponentStorage<T>& storage = getStorage<T>();
+        const std::vector<uint32_t>& versions = storage.getVersions();
+        const std::vector<int>& objectIDs = storage.getObjectIDs();
+
+        changedIDs.clear();
+        for (size_t i = 0; i < versions.size(); ++i) {
+            if (versions[i] > version) {
+                changedIDs.push_back(objectIDs[i]);
+            }
+        }
+    }
+
+    /**
+     * @brief Capture the current change version and start a new one.
+     *
+     * Every change made after this call is stamped with a later version, so passing the returned
+     * value to hasChangedSince()/getChangedSince() reports exactly the changes made afterwards.
+     *
+     * @return The captured version.
+     */
+    uint32_t captureVersion() {
+        return changeVersion++;
+    }
+
+    /**
+     * @brief Accessor for the dense storage holding every property of the given type.
+     * @return The storage for the property type.
+     */
+    template <typename T>
+    ComponentStorage<T>& getStorage() {
+        static_assert(std::is_base_of<Property, T>::value, "Property types must derive from Property");
+
+        std::unique_ptr<IComponentStorage>& storage = storages[T::TYPE];
+        if (!storage) {
+            storage.reset(createComponentStorage<T>());
         }
-        return nullptr;
+        return static_cast<ComponentStorage<T>&>(*storage);
+    }
+
+    /**
+     * @brief Pre-allocate room for a number of objects.
+     *
+     * Destroyed objects return their slot to a free list, but a slot is only reused once more than
+     * MINIMUM_FREE_SLOTS are waiting (see createObject()), so objectCount + MINIMUM_FREE_SLOTS slots
+     * are reserved. After reserving, spawning and destroying objects does not allocate as long as
+     * no more than objectCount are alive at once.
+     *
+     * @param objectCount The number of simultaneously live objects to make room for.
+     */
+    void reserveObjects(size_t objectCount) {
+        size_t slotCount = objectCount + MINIMUM_FREE_SLOTS;
+        slots.reserve(slotCount);
+        signatures.reserve(slotCount);
+        if (freeSlots.size() < slotCount) {
+            resizeFreeSlots(slotCount);
+        }
+    }
+
+    /**
+     * @brief Pre-allocate room for a number of properties of the given type.
+     * @param count The number of properties of this type to make room for.
+     */
+    template <typename T>
+    void reserveProperties(size_t count) {
+        getStorage<T>().reserve(count, slots.capacity());
+    }
+
+    /**
+     * @brief Create a view over every object that has all of the given property types.
+     *
+     * Example: view<RectProperty, VelocityProperty>().each([](int id, RectProperty& rect, VelocityProperty& vel) { ... });
+     *
+     * @return A view that iterates the smallest of the requested storages.
+     */
+    template <typename... Ts>
+    PropertyView<Ts...> view() {
+        return PropertyView<Ts...>(signatures, getStorage<Ts>()...);
     }
 
     /**
-     * @brief Check if an object exists in the properties map.
+     * @brief Check if an object exists.
      * @param objectID The ID of the object.
-     * @return True if the object exists, false otherwise.
+     * @return True if the object exists, false if it was never created or has been destroyed.
      */
     bool hasObject(int objectID) const {
-        return properties.count(objectID) > 0;
+        if (objectID < 0) {
+            return false;
+        }
+        int index = Entity::getIndex(objectID);
+        return index < static_cast<int>(slots.size()) && slots[index].alive
+            && slots[index].generation == Entity::getGeneration(objectID);
     }
 
     /**
-     * @brief Create a new game object and return its unique ID.
-     * @return The unique ID of the new game object.
+     * @brief Create a new game object and return its ID.
+     *
+     * Freed slots are reused oldest first, and only once more than MINIMUM_FREE_SLOTS are waiting,
+     * so a slot comes back at most once per MINIMUM_FREE_SLOTS destroyed objects. Even when one
+     * object is created and destroyed over and over, a stale ID would need that many times
+     * Entity::GENERATION_MASK + 1 destroys before its generation comes round again.
+     *
+     * @return The ID of the new game object.
      */
     int createObject() {
-        static int nextID = 0;
-        return nextID++;  // Generate and return a unique object ID
+        int index;
+        if (freeSlotCount > MINIMUM_FREE_SLOTS) {
+            index = popFreeSlot();
+        }
+        else {
+            index = static_cast<int>(slots.size());
+            slots.push_back(Slot());
+            signatures.push_back(0);
+        }
+
+        slots[index].alive = true;
+        return Entity::makeID(index, slots[index].generation);
+    }
+
+    /**
+     * @brief Create a new game object from a prefab.
+     * @param prefab The property bundle the new object starts with.
+     * @return The ID of the new game object.
+     */
+    int instantiate(const Prefab& prefab) {
+        int objectID = createObject();
+        signatures[Entity::getIndex(objectID)] = prefab.getSignature();
+        for (const Prefab::Entry& entry : prefab.getEntries()) {
+            getStorage(entry).insertRaw(objectID, prefab.getPayload(entry), changeVersion);
+        }
+        return objectID;
+    }
+
+    /**
+     * @brief Create many game objects from a prefab in one batch.
+     *
+     * All objects are created first, then each property type of the prefab is appended to its
+     * storage in a single bulk fill.
+     *
+     * @param prefab The property bundle every new object starts with.
+     * @param count The number of objects to create.
+     * @param objectIDs Receives the IDs of the new objects, appended in creation order.
+     */
+    void instantiate(const Prefab& prefab, size_t count, std::vector<int>& objectIDs) {
+        size_t first = objectIDs.size();
+        objectIDs.reserve(first + count);
+        for (size_t i = 0; i < count; ++i) {
+            int objectID = createObject();
+            signatures[Entity::getIndex(objectID)] = prefab.getSignature();
+            objectIDs.push_back(objectID);
+        }
+
+        for (const Prefab::Entry& entry : prefab.getEntries()) {
+            getStorage(entry).insertBatchRaw(objectIDs.data() + first, count, prefab.getPayload(entry), changeVersion);
+        }
     }
 
     /**
      * @brief Remove a game object and all its associated properties.
+     *
+     * The object's slot is returned to the free list and its generation is bumped, so the
+     * destroyed ID stops resolving immediately.
+     *
      * @param objectID The ID of the object to remove.
      */
     void destroyObject(int objectID) {
-        properties.erase(objectID);
+        if (!hasObject(objectID)) {
+            return;
+        }
+
+        for (auto& storage : storages) {
+            if (storage) {
+                storage->remove(objectID);
+            }
+        }
+
+        int index = Entity::getIndex(objectID);
+        signatures[index] = 0;
+        slots[index].alive = false;
+        slots[index].generation = (slots[index].generation + 1) & Entity::GENERATION_MASK;
+        pushFreeSlot(index);
     }
 
     /**
-     * @brief Accessor for the entire properties map.
-     * @return The entire properties map.
+     * @brief Accessor for the manager's default command buffer.
+     *
+     * Record structural changes here while iterating storages or views, then apply them all at
+     * once with applyCommands().
+     *
+     * @return The default command buffer.
      */
-    const std::unordered_map<int, std::unordered_map<std::string, std::shared_ptr<Property>>>& getAllProperties() const {
-        return properties;
+    PropertyCommandBuffer& getCommandBuffer() {
+        return commandBuffer;
+    }
+
+    /**
+     * @brief Play back and clear the default command buffer.
+     */
+    void applyCommands() {
+        playback(commandBuffer);
+    }
+
+    /**
+     * @brief Apply every command recorded in a buffer, in order, then clear it.
+     *
+     * Commands that target objects destroyed earlier in the same playback are ignored.
+     *
+     * @param buffer The command buffer to play back.
+     */
+    void playback(PropertyCommandBuffer& buffer) {
+        createdIDs.clear();
+
+        for (const PropertyCommandBuffer::Command& command : buffer.getCommands()) {
+            // Resolve temporary IDs from createObject() calls recorded earlier in this buffer
+            int objectID = command.objectID;
+            if (objectID < Entity::INVALID_ID && command.type != PropertyCommandBuffer::CREATE_OBJECT) {
+                objectID = createdIDs[PropertyCommandBuffer::getTemporaryIndex(objectID)];
+            }
+
+            switch (command.type) {
+            case PropertyCommandBuffer::CREATE_OBJECT:
+                createdIDs.push_back(createObject());
+                break;
+            case PropertyCommandBuffer::ADD_PROPERTY:
+                if (hasObject(objectID)) {
+                    std::unique_ptr<IComponentStorage>& storage = storages[command.propertyType];
+                    if (!storage) {
+                        storage.reset(command.createStorage());
+                    }
+                    storage->insertRaw(objectID, buffer.getPayload(command), changeVersion);
+                    signatures[Entity::getIndex(objectID)] |= PropertySignature(1) << command.propertyType;
+                }
+                break;
+            case PropertyCommandBuffer::DESTROY_OBJECT:
+                destroyObject(objectID);
+                break;
+            }
+        }
+
+        buffer.clear();
     }
 
 private:
-    PropertyManager() = default;
-    ~PropertyManager() = default;
+    friend class WorldSnapshot; // Saves and restores the raw slot and storage arrays
 
-    // Prevent copy constructor and assignment
-    PropertyManager(const PropertyManager&) = delete;
-    PropertyManager& operator=(const PropertyManager&) = delete;
+    // Queue a freed slot for reuse; the ring only grows past the most slots ever free at once
+    void pushFreeSlot(int index) {
+        if (freeSlotCount == freeSlots.size()) {
+            resizeFreeSlots(std::max<size_t>(freeSlots.size() * 2, 16));
+        }
+        freeSlots[(freeSlotHead + freeSlotCount) % freeSlots.size()] = index;
+        ++freeSlotCount;
+    }
+
+    // Take the oldest freed slot off the queue
+    int popFreeSlot() {
+        int index = freeSlots[freeSlotHead];
+        freeSlotHead = (freeSlotHead + 1) % freeSlots.size();
+        --freeSlotCount;
+        return index;
+    }
+
+    // Move the queued slots, oldest first, into a ring of the given size
+    void resizeFreeSlots(size_t capacity) {
+        std::vector<int> resized(capacity);
+        for (size_t i = 0; i < freeSlotCount; ++i) {
+            resized[i] = freeSlots[(freeSlotHead + i) % freeSlots.size()];
+        }
+        freeSlots.swap(resized);
+        freeSlotHead = 0;
+    }
+
+    // Storage for a prefab entry, created on first use
+    IComponentStorage& getStorage(const Prefab::Entry& entry) {
+        std::unique_ptr<IComponentStorage>& storage = storages[entry.propertyType];
+        if (!storage) {
+            storage.reset(entry.createStorage());
+        }
+        return *storage;
+    }
+
+    /**
+     * @brief Bookkeeping for one object slot.
+     */
+    struct Slot {
+        int generation = 0; // Generation of the object currently (or last) using the slot
+        bool alive = false; // Whether the slot holds a live object
+    };
+
+    std::vector<Slot> slots;    // One entry per slot index ever handed out
+    std::vector<PropertySignature> signatures; // Property types held by the object in each slot (0 if none)
+    static const size_t MINIMUM_FREE_SLOTS = 1024; // Freed slots kept waiting before any is reused
 
-    std::unordered_map<int, std::unordered_map<std::string, std::shared_ptr<Property>>> properties;
+    std::vector<int> freeSlots; // Ring of the indices of destroyed objects, reused oldest first
+    size_t freeSlotHead = 0;    // Position in freeSlots of the oldest freed slot
+    size_t freeSlotCount = 0;   // Number of freed slots queued in the ring
+    uint32_t changeVersion = 1;          // Version stamped on properties as they change (0 means "before anything")
+    PropertyCommandBuffer commandBuffer; // Default buffer for deferred structural changes
+    std::vector<int> createdIDs;         // Real IDs of objects created during the current playback
+    std::array<std::unique_ptr<IComponentStorage>, PROPERTY_TYPE_COUNT> storages; // One dense storage per property type, indexed by TYPE
 };
 
 #endif // PROPERTY_MANAGER_H
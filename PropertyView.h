@@ -0,0 +1,143 @@
+#ifndef PROPERTY_VIEW_H
+#define PROPERTY_VIEW_H
+
+#include <tuple>
+#include <utility>
+#include <vector>
+#include <cstddef>
+#include "ComponentStorage.h"
+#include "Property.h"
+#include "Entity.h"
+
+/**
+ * @brief A query over every object that has all of the given property types.
+ *
+ * Get one from PropertyManager::view(); adding or removing a viewed property type while iterating invalidates it.
+ */
+template <typename... Ts>
+class PropertyView {
+public:
+    /**
+     * @brief Forward iterator over the IDs of matching objects.
+     */
+    class Iterator {
+    public:
+        Iterator(const PropertyView* view, size_t position) : view(view), position(position) {
+            skipToMatch();
+        }
+
+        int operator*() const {
+            return (*view->candidates)[position];
+        }
+
+        Iterator& operator++() {
+            ++position;
+            skipToMatch();
+            return *this;
+        }
+
+        bool operator!=(const Iterator& other) const {
+            return position != other.position;
+        }
+
+        bool operator==(const Iterator& other) const {
+            return position == other.position;
+        }
+
+    private:
+        void skipToMatch() {
+            while (position < view->candidates->size() && !view->matches((*view->candidates)[position])) {
+                ++position;
+            }
+        }
+
+        const PropertyView* view; // The view being iterated
+        size_t position;          // Position in the candidate object list
+    };
+
+    /**
+     * @brief Construct a view over the given storages.
+     * @param signatures The property signature of every object slot, indexed by slot index.
+     * @param storages The storage for each requested property type.
+     */
+    PropertyView(const std::vector<PropertySignature>& signatures, ComponentStorage<Ts>&... storages)
+        : storages(&storages...), candidates(&smallest(storages...)), signatures(&signatures),
+          signature(makeSignature<Ts...>()) {}
+
+    Iterator begin() const {
+        return Iterator(this, 0);
+    }
+
+    Iterator end() const {
+        return Iterator(this, candidates->size());
+    }
+
+    /**
+     * @brief Check whether an object has every property in the view.
+     * @param objectID The ID of the object.
+     * @return True if the object matches the view, false otherwise.
+     */
+    bool contains(int objectID) const {
+        return containsAll(objectID, std::index_sequence_for<Ts...>());
+    }
+
+    /**
+     * @brief Get one of the viewed properties of a matching object.
+     * @param objectID The ID of the object.
+     * @return A reference to the property.
+     */
+    template <typename T>
+    T& get(int objectID) const {
+        return *std::get<ComponentStorage<T>*>(storages)->get(objectID);
+    }
+
+    /**
+     * @brief Invoke a function for every matching object.
+     *
+     * The function is called as func(objectID, properties...) with a reference to each viewed
+     * property, in the order the property types were given to the view.
+     *
+     * @param func The function to invoke.
+     */
+    template <typename Func>
+    void each(Func func) const {
+        for (int objectID : *this) {
+            func(objectID, *std::get<ComponentStorage<Ts>*>(storages)->get(objectID)...);
+        }
+    }
+
+private:
+    // Candidates come from a storage, so they are always live and their slot's signature is theirs
+    bool matches(int objectID) const {
+        return ((*signatures)[Entity::getIndex(objectID)] & signature) == signature;
+    }
+
+    template <size_t... Is>
+    bool containsAll(int objectID, std::index_sequence<Is...>) const {
+        bool results[] = { std::get<Is>(storages)->has(objectID)... };
+        for (bool result : results) {
+            if (!result) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <typename First>
+    static const std::vector<int>& smallest(ComponentStorage<First>& first) {
+        return first.getObjectIDs();
+    }
+
+    template <typename First, typename Second, typename... Rest>
+    static const std::vector<int>& smallest(ComponentStorage<First>& first, ComponentStorage<Second>& second, ComponentStorage<Rest>&... rest) {
+        const std::vector<int>& others = smallest(second, rest...);
+        return first.size() <= others.size() ? first.getObjectIDs() : others;
+    }
+
+    std::tuple<ComponentStorage<Ts>*...> storages; // Storages for each viewed property type
+    const std::vector<int>* candidates;            // Object list of the smallest storage
+    const std::vector<PropertySignature>* signatures; // Signature of every object slot
+    PropertySignature signature;                   // Signature of the viewed property types
+};
+
+#endif // PROPERTY_VIEW_H
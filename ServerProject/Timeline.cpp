@@ -1,67 +1,133 @@
 #include "Timeline.h"
+#include <thread>
 
 // Define the target ticks per second (e.g., 60 FPS)
 const float Timeline::targetTPS = 60.0f;
 
 Timeline::Timeline(Timeline* anchor, float tic)
-    : tic(tic), paused(false), elapsedPausedTime(std::chrono::seconds(0)) {
-    // Initialize the timeline with the start time
-    startTime = std::chrono::system_clock::now();  // Record the start time
+    : startTime(std::chrono::steady_clock::now()), anchor(anchor), sequence(0), anchorOrigin(0), timeOrigin(0), tic(tic), paused(false) {
+    // Start at time 0 from wherever the anchor is now
+    anchorOrigin.store(getAnchorTime(), std::memory_order_relaxed);
 }
 
-// Get the current time relative to the anchor
-int64_t Timeline::getTime() const {
-    auto now = std::chrono::system_clock::now();
-    std::chrono::duration<float> elapsedTime;
+// Read the anchor's time, or real time since the start for a root timeline
+int64_t Timeline::getAnchorTime() const {
+    if (anchor) {
+        return anchor->getTimeNanos();
+    }
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime).count();
+}
 
-    // Calculate elapsed time based on whether the timeline is paused or running
+// Convert an anchor time to this timeline's time
+int64_t Timeline::toLocalTime(int64_t anchorTime, int64_t anchorOrigin, int64_t timeOrigin, float tic, bool paused) {
     if (paused) {
-        // If paused, compute elapsed time up to lastPausedTime
-        elapsedTime = lastPausedTime - startTime - elapsedPausedTime;
+        return timeOrigin;  // Frozen at the time of pausing
     }
-    else {
-        // If not paused, compute elapsed time up to now
-        elapsedTime = now - startTime - elapsedPausedTime;
+    int64_t elapsed = anchorTime - anchorOrigin;
+    if (tic != 1.0f) {
+        elapsed = static_cast<int64_t>(static_cast<double>(elapsed) / tic);  // Adjust the time by the tic rate
     }
+    return timeOrigin + elapsed;
+}
 
-    elapsedTime /= tic;  // Adjust the time by the current tic rate
+// Begin a change of the state, waiting out any other writer
+uint64_t Timeline::beginWrite() {
+    uint64_t current = sequence.load(std::memory_order_relaxed);
+    while (true) {
+        // An odd sequence means another thread is mid-change; claim it by making the sequence odd
+        if ((current & 1) == 0 && sequence.compare_exchange_weak(current, current + 1, std::memory_order_relaxed)) {
+            break;
+        }
+        if (current & 1) {
+            std::this_thread::yield();
+            current = sequence.load(std::memory_order_relaxed);
+        }
+    }
+    std::atomic_thread_fence(std::memory_order_release);  // Readers that see the new state also see the odd sequence
+    return current + 1;
+}
+
+// Publish a change of the state
+void Timeline::endWrite(uint64_t writeSequence) {
+    sequence.store(writeSequence + 1, std::memory_order_release);
+}
 
-    // Return the elapsed time in milliseconds
-    return static_cast<int64_t>(elapsedTime.count() * 1000.0f);
+// Get the current time relative to the anchor, in milliseconds
+int64_t Timeline::getTime() const {
+    return getTimeNanos() / 1000000;
+}
+
+// Get the current time relative to the anchor, in nanoseconds
+int64_t Timeline::getTimeNanos() const {
+    while (true) {
+        uint64_t before = sequence.load(std::memory_order_acquire);
+        int64_t anchorTime = getAnchorTime();
+        int64_t currentAnchorOrigin = anchorOrigin.load(std::memory_order_relaxed);
+        int64_t currentTimeOrigin = timeOrigin.load(std::memory_order_relaxed);
+        float currentTic = tic.load(std::memory_order_relaxed);
+        bool currentPaused = paused.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        // Retry if a writer changed the state while it was being read
+        if ((before & 1) == 0 && sequence.load(std::memory_order_relaxed) == before) {
+            return toLocalTime(anchorTime, currentAnchorOrigin, currentTimeOrigin, currentTic, currentPaused);
+        }
+        std::this_thread::yield();
+    }
 }
 
 // Pause the timeline
 void Timeline::pause() {
-    if (!paused) {
-        // Set paused state and record the time when the timeline was paused
-        paused = true;
-        lastPausedTime = std::chrono::system_clock::now();
+    uint64_t writeSequence = beginWrite();
+    if (!paused.load(std::memory_order_relaxed)) {
+        // Freeze the time at the moment of pausing
+        int64_t now = toLocalTime(getAnchorTime(), anchorOrigin.load(std::memory_order_relaxed), timeOrigin.load(std::memory_order_relaxed),
+            tic.load(std::memory_order_relaxed), false);
+        timeOrigin.store(now, std::memory_order_relaxed);
+        paused.store(true, std::memory_order_relaxed);
     }
+    endWrite(writeSequence);
 }
 
 // Unpause the timeline
 void Timeline::unpause() {
-    if (paused) {
-        // Calculate the time since it was paused and update the paused time
-        auto now = std::chrono::system_clock::now();
-        elapsedPausedTime += now - lastPausedTime;  // Add paused duration to total paused time
-        paused = false;  // Reset the paused state
+    uint64_t writeSequence = beginWrite();
+    if (paused.load(std::memory_order_relaxed)) {
+        // Resume counting from the frozen time, so the paused duration is skipped
+        anchorOrigin.store(getAnchorTime(), std::memory_order_relaxed);
+        paused.store(false, std::memory_order_relaxed);
     }
+    endWrite(writeSequence);
 }
 
 // Check if the timeline is paused
 bool Timeline::isPaused() const {
-    return paused;
+    return paused.load(std::memory_order_relaxed);
 }
 
 // Change the tic rate
 void Timeline::changeTic(float newTic) {
-    tic = newTic;  // Set the new tic rate for the timeline
+    uint64_t writeSequence = beginWrite();
+    if (!paused.load(std::memory_order_relaxed)) {
+        // Bank the time elapsed at the old rate, then count on from here at the new one
+        int64_t anchorTime = getAnchorTime();
+        int64_t now = toLocalTime(anchorTime, anchorOrigin.load(std::memory_order_relaxed), timeOrigin.load(std::memory_order_relaxed),
+            tic.load(std::memory_order_relaxed), false);
+        timeOrigin.store(now, std::memory_order_relaxed);
+        anchorOrigin.store(anchorTime, std::memory_order_relaxed);
+    }
+    tic.store(newTic, std::memory_order_relaxed);  // Set the new tic rate for the timeline
+    endWrite(writeSequence);
 }
 
 // Get the current tic rate
 float Timeline::getTic() const {
-    return tic;  // Return the current tic rate
+    return tic.load(std::memory_order_relaxed);  // Return the current tic rate
+}
+
+// Get the anchor timeline
+Timeline* Timeline::getAnchor() const {
+    return anchor;
 }
 
 // Getter for target ticks per second (for use in frame delta calculation)
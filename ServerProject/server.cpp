@@ -158,6 +158,23 @@ void handleEvents(zmq::socket_t& eventRepSocket) {
     }
 }
 
+// Relays replicated event batches from every client to every client
+void relayEvents(zmq::socket_t& eventPullSocket, zmq::socket_t& eventPubSocket) {
+    while (true) {
+        zmq::message_t batch;
+
+        try {
+            // Batches are forwarded untouched; each client drops its own and re-raises the rest
+            if (eventPullSocket.recv(batch, zmq::recv_flags::none)) {
+                eventPubSocket.send(batch, zmq::send_flags::none);
+            }
+        }
+        catch (const zmq::error_t& e) {
+            std::cerr << "Error relaying events: " << e.what() << std::endl;
+        }
+    }
+}
+
 // Checks for disconnected clients based on heartbeat intervals
 void checkForTimeouts() {
     while (true) {
@@ -190,23 +207,29 @@ int main() {
     zmq::socket_t repSocket(context, zmq::socket_type::rep); // Socket for client requests
     zmq::socket_t pubSocket(context, zmq::socket_type::pub); // Socket for broadcasting updates
     zmq::socket_t eventRepSocket(context, zmq::socket_type::rep); // Socket for event handling
+    zmq::socket_t eventPullSocket(context, zmq::socket_type::pull); // Socket for receiving replicated event batches
+    zmq::socket_t eventPubSocket(context, zmq::socket_type::pub); // Socket for publishing replicated event batches
 
     // Bind sockets to ports
     repSocket.bind("tcp://*:5555");
     pubSocket.bind("tcp://*:5556");
     eventRepSocket.bind("tcp://*:5557");
+    eventPullSocket.bind("tcp://*:5558");
+    eventPubSocket.bind("tcp://*:5559");
 
     // Start threads for handling different server functions
     std::thread requestThread(handleRequests, std::ref(repSocket));
     std::thread broadcastThread(broadcastPositions, std::ref(pubSocket));
     std::thread timeoutThread(checkForTimeouts);
     std::thread eventThread(handleEvents, std::ref(eventRepSocket));
+    std::thread relayThread(relayEvents, std::ref(eventPullSocket), std::ref(eventPubSocket));
 
     // Wait for threads to complete
     requestThread.join();
     broadcastThread.join();
     timeoutThread.join();
     eventThread.join();
+    relayThread.join();
 
     return 0;
 }
@@ -1,8 +1,20 @@
 #include "SpawnEvent.h"
 
+static_assert(sizeof(SpawnEvent) == sizeof(Event), "SpawnEvent keeps its data in the event payload");
+
+// Packs the object ID into the inline payload
+static EventPayload makeObjectPayload(int objectID) {
+    EventPayload payload = {};
+    payload.object.objectID = objectID;
+    return payload;
+}
+
 SpawnEvent::SpawnEvent(int objectID, Timeline* timeline)
-    : Event(SPAWN, 3, timeline), objectID(objectID) {}
+    : Event(SPAWN, 3, timeline, makeObjectPayload(objectID)) {}
+
+SpawnEvent::SpawnEvent(const Event& event)
+    : Event(event) {}
 
 int SpawnEvent::getObjectID() const {
-    return objectID;
+    return getPayload().object.objectID;
 }
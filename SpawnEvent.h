@@ -29,15 +29,19 @@ public:
      */
     SpawnEvent(int objectID, Timeline* timeline);
 
+    /**
+     * @brief Views a dispatched event as a SpawnEvent.
+     *
+     * @param event An event whose type is SPAWN.
+     */
+    explicit SpawnEvent(const Event& event);
+
     /**
      * @brief Retrieves the ID of the object associated with this spawn event.
      *
      * @return The object ID for the spawn event.
      */
     int getObjectID() const;
-
-private:
-    int objectID; // ID of the object that triggered the spawn event.
 };
 
 #endif // SPAWN_EVENT_H
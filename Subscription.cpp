@@ -0,0 +1,40 @@
+#include "Subscription.h"
+#include "EventManager.h"
+
+Subscription::Subscription()
+    : manager(nullptr), eventType(EVENT_TYPE_COUNT), objectID(Event::NO_OBJECT), id(0) {}
+
+Subscription::Subscription(EventManager* manager, EventType eventType, int objectID, uint32_t id)
+    : manager(manager), eventType(eventType), objectID(objectID), id(id) {}
+
+Subscription::~Subscription() {
+    unsubscribe();
+}
+
+Subscription::Subscription(Subscription&& other)
+    : manager(other.manager), eventType(other.eventType), objectID(other.objectID), id(other.id) {
+    other.manager = nullptr;
+}
+
+Subscription& Subscription::operator=(Subscription&& other) {
+    if (this != &other) {
+        unsubscribe();
+        manager = other.manager;
+        eventType = other.eventType;
+        objectID = other.objectID;
+        id = other.id;
+        other.manager = nullptr;
+    }
+    return *this;
+}
+
+void Subscription::unsubscribe() {
+    if (manager) {
+        manager->unsubscribe(eventType, objectID, id);
+        manager = nullptr;
+    }
+}
+
+bool Subscription::isActive() const {
+    return manager != nullptr;
+}
@@ -0,0 +1,66 @@
+#ifndef SUBSCRIPTION_H
+#define SUBSCRIPTION_H
+
+#include <cstdint>
+#include "Event.h"
+
+class EventManager;
+
+/**
+ * @brief Token for a handler registered with EventManager::subscribe().
+ *
+ * The handler stays registered for as long as the token exists. Destroying the token, assigning
+ * another subscription to it, or calling unsubscribe() removes the handler, so an object that keeps
+ * its subscriptions as members stops receiving events when it is destroyed. Tokens can be moved
+ * but not copied, and must not outlive the EventManager that issued them.
+ */
+class Subscription {
+public:
+    /**
+     * @brief Constructs an empty token that holds no subscription.
+     */
+    Subscription();
+
+    /**
+     * @brief Removes the handler, if the token still holds one.
+     */
+    ~Subscription();
+
+    Subscription(Subscription&& other);
+    Subscription& operator=(Subscription&& other);
+
+    Subscription(const Subscription&) = delete;
+    Subscription& operator=(const Subscription&) = delete;
+
+    /**
+     * @brief Removes the handler now. Safe to call from inside a handler during dispatch.
+     */
+    void unsubscribe();
+
+    /**
+     * @brief Checks whether the token still holds a registered handler.
+     *
+     * @return True if the handler is registered, false otherwise.
+     */
+    bool isActive() const;
+
+private:
+    friend class EventManager;
+
+    /**
+     * @brief Constructs a token for a registered handler. Only EventManager creates these.
+     *
+     * @param manager The manager the handler is registered with.
+     * @param eventType The event type the handler is registered for.
+     * @param objectID The manager's key for the handler's list (the object it is registered for, or Event::NO_OBJECT for every object).
+     * @param id The manager's ID for the handler.
+     */
+    Subscription(EventManager* manager, EventType eventType, int objectID, uint32_t id);
+
+    EventManager* manager; // Manager holding the handler, or nullptr if the token is empty
+    EventType eventType;   // Event type the handler is registered for (EVENT_TYPE_COUNT for a typed event)
+    int objectID;          // Manager's key for the handler's list (usually the object it is registered for, or a typed event's channel ID)
+    uint32_t id;           // ID of the handler within the manager
+};
+
+#endif // SUBSCRIPTION_H
@@ -1,35 +1,70 @@
 #pragma once
 #include <chrono>
-#include <mutex>
+#include <atomic>
+#include <cstdint>
 
 /**
  * Timeline class represents a flexible time system that can track real or game time, handle
  * time scaling, and support features such as pausing, unpausing, and time anchoring. It is thread-safe
- * for multithreaded environments.
+ * for multithreaded environments: readers never block, and never see a half-applied pause or tic change.
+ *
+ * A timeline without an anchor measures real time on the monotonic steady clock. An anchored timeline
+ * measures its anchor's time instead, so pausing or slowing a timeline pauses or slows every timeline
+ * anchored to it, however deep the hierarchy, without touching the children. Time is kept as integer
+ * nanoseconds, so it stays exact however long the timeline runs.
  */
 class Timeline {
 private:
-    std::chrono::time_point<std::chrono::system_clock> startTime;  // The time point when the timeline started
-    std::chrono::time_point<std::chrono::system_clock> lastPausedTime;  // The time point when the timeline was last paused
-    std::chrono::duration<float> elapsedPausedTime;  // Accumulated duration of time spent paused
+    const std::chrono::steady_clock::time_point startTime;  // The time point when the timeline started (read by root timelines)
+    Timeline* const anchor;  // The timeline whose time this one measures, or nullptr for real time
 
-    float tic;  // The number of anchor timeline units per step, allowing time scaling
-    bool paused;  // Indicates whether the timeline is currently paused
-
-    std::mutex m;  // Mutex to ensure thread-safe updates to the timeline state
+    // The timeline's state, changed as a whole by writers and read as a whole through the sequence (a seqlock)
+    std::atomic<uint64_t> sequence;  // Even while the state is stable, odd while a writer is changing it
+    std::atomic<int64_t> anchorOrigin;  // Anchor time, in nanoseconds, at which the timeline read timeOrigin
+    std::atomic<int64_t> timeOrigin;  // The timeline's own time, in nanoseconds, at anchorOrigin (or since pausing)
+    std::atomic<float> tic;  // The number of anchor timeline units per step, allowing time scaling
+    std::atomic<bool> paused;  // Indicates whether the timeline is currently paused
 
     static const float targetTPS;  // Target ticks per second, representing how often updates should occur
 
+    /**
+     * Reads the time this timeline is measured against: the anchor's time, or real time since the start.
+     *
+     * @return The anchor time in nanoseconds
+     */
+    int64_t getAnchorTime() const;
+
+    /**
+     * Converts an anchor time to this timeline's time, given one consistent copy of the state.
+     */
+    static int64_t toLocalTime(int64_t anchorTime, int64_t anchorOrigin, int64_t timeOrigin, float tic, bool paused);
+
+    /**
+     * Starts a change of the state; waits for any other writer to finish first.
+     *
+     * @return The sequence number to pass to endWrite()
+     */
+    uint64_t beginWrite();
+
+    /**
+     * Publishes a change of the state started with beginWrite().
+     */
+    void endWrite(uint64_t writeSequence);
+
 public:
     /**
      * Constructor for the Timeline class. Initializes a timeline object with optional
-     * anchoring and a customizable tic rate.
+     * anchoring and a customizable tic rate. The timeline starts at time 0.
      *
-     * @param anchor A pointer to another timeline that this timeline can be anchored to (optional)
+     * @param anchor A pointer to another timeline that this timeline measures its time against (optional);
+     *        it must outlive this timeline
      * @param tic The number of units per step, controlling the rate of time scaling (default is 1.0 for real-time)
      */
     Timeline(Timeline* anchor = nullptr, float tic = 1.0f);
 
+    Timeline(const Timeline&) = delete;
+    Timeline& operator=(const Timeline&) = delete;
+
     /**
      * Get the current time relative to the timeline's start. Accounts for pausing and time scaling.
      *
@@ -38,8 +73,15 @@ public:
     int64_t getTime() const;
 
     /**
-     * Pauses the timeline, freezing time. All objects depending on this timeline will stop moving
-     * or updating until the timeline is unpaused.
+     * Get the current time relative to the timeline's start at full resolution.
+     *
+     * @return The current time in nanoseconds, adjusted for elapsed time and pause duration
+     */
+    int64_t getTimeNanos() const;
+
+    /**
+     * Pauses the timeline, freezing time. All objects depending on this timeline, and every timeline
+     * anchored to it, will stop moving or updating until the timeline is unpaused.
      */
     void pause();
 
@@ -50,7 +92,8 @@ public:
     void unpause();
 
     /**
-     * Checks whether the timeline is currently paused.
+     * Checks whether the timeline is currently paused. A timeline whose anchor is paused is frozen too,
+     * but is not paused itself, and resumes along with its anchor.
      *
      * @return True if the timeline is paused, false otherwise
      */
@@ -58,7 +101,7 @@ public:
 
     /**
      * Changes the tic rate (time scaling) of the timeline. Adjusting this allows the timeline to run
-     * faster or slower than real-time.
+     * faster or slower than real-time. Time already elapsed is kept, so the timeline does not jump.
      *
      * @param newTic The new tic rate
      */
@@ -71,6 +114,13 @@ public:
      */
     float getTic() const;
 
+    /**
+     * Retrieves the anchor this timeline measures its time against.
+     *
+     * @return The anchor, or nullptr if the timeline measures real time
+     */
+    Timeline* getAnchor() const;
+
     /**
      * Retrieves the target ticks per second (TPS) for the game loop.
      *
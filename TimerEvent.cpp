@@ -0,0 +1,20 @@
+#include "TimerEvent.h"
+
+static_assert(sizeof(TimerEvent) == sizeof(Event), "TimerEvent keeps its data in the event payload");
+
+// Packs the timer ID into the inline payload
+static EventPayload makeTimerPayload(int timerID) {
+    EventPayload payload = {};
+    payload.timer.timerID = timerID;
+    return payload;
+}
+
+TimerEvent::TimerEvent(int timerID, Timeline* timeline)
+    : Event(TIMER, 1, timeline, makeTimerPayload(timerID)) {}
+
+TimerEvent::TimerEvent(const Event& event)
+    : Event(event) {}
+
+int TimerEvent::getTimerID() const {
+    return getPayload().timer.timerID;
+}
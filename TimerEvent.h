@@ -0,0 +1,39 @@
+#ifndef TIMER_EVENT_H
+#define TIMER_EVENT_H
+
+#include "Event.h"
+
+/**
+ * @brief Represents a timer firing.
+ *
+ * A TimerEvent is scheduled with EventManager::scheduleEvent() to make something happen after a
+ * delay on a timeline, such as the next step of a wave. A handler that wants to fire again
+ * schedules the next TimerEvent itself. The timer ID doubles as the event's object ID, so a
+ * handler can subscribe to a single timer.
+ */
+class TimerEvent : public Event {
+public:
+    /**
+     * @brief Constructs a new TimerEvent.
+     *
+     * @param timerID The ID of the timer.
+     * @param timeline Pointer to the game's timeline (for event timestamping and the delay).
+     */
+    TimerEvent(int timerID, Timeline* timeline);
+
+    /**
+     * @brief Views a dispatched event as a TimerEvent.
+     *
+     * @param event An event whose type is TIMER.
+     */
+    explicit TimerEvent(const Event& event);
+
+    /**
+     * @brief Gets the ID of the timer that fired.
+     *
+     * @return int The ID of the timer.
+     */
+    int getTimerID() const;
+};
+
+#endif // TIMER_EVENT_H
@@ -0,0 +1,103 @@
+#include "WorkerPool.h"
+#include <chrono>
+
+// Start the worker threads
+WorkerPool::WorkerPool(size_t threadCount) {
+    threads.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i) {
+        threads.emplace_back(&WorkerPool::workerLoop, this);
+    }
+}
+
+// Stop and join the worker threads
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+// Get the number of worker threads
+size_t WorkerPool::getThreadCount() const {
+    return threads.size();
+}
+
+// Run a batch of tasks across the workers and the calling thread
+void WorkerPool::run(size_t taskCount, const std::function<void(size_t)>& task, const std::function<void()>& onWait) {
+    if (taskCount == 0) {
+        return;
+    }
+    if (threads.empty() || taskCount == 1) {
+        for (size_t i = 0; i < taskCount; ++i) {
+            task(i);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        currentTask = &task;
+        currentTaskCount = taskCount;
+        nextTask.store(0, std::memory_order_relaxed);
+        completedTasks.store(0, std::memory_order_relaxed);
+        ++batch;
+    }
+    wake.notify_all();
+
+    runTasks(task, taskCount);
+
+    // Wait until every task is finished and no worker still holds on to this batch
+    std::unique_lock<std::mutex> lock(mutex);
+    auto finished = [this, taskCount]() {
+        return completedTasks.load(std::memory_order_acquire) == taskCount && busyWorkers == 0;
+    };
+    while (!done.wait_for(lock, std::chrono::milliseconds(1), finished)) {
+        if (onWait) {
+            lock.unlock();
+            onWait();
+            lock.lock();
+        }
+    }
+    currentTask = nullptr;
+}
+
+// Body of each worker thread
+void WorkerPool::workerLoop() {
+    uint64_t seenBatch = 0;
+    while (true) {
+        const std::function<void(size_t)>* task;
+        size_t taskCount;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this, seenBatch]() { return stopping || (currentTask && batch != seenBatch); });
+            if (stopping) {
+                return;
+            }
+            seenBatch = batch;
+            task = currentTask;
+            taskCount = currentTaskCount;
+            ++busyWorkers;
+        }
+
+        runTasks(*task, taskCount);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            --busyWorkers;
+        }
+        done.notify_one();
+    }
+}
+
+// Claim and run tasks until none are left
+void WorkerPool::runTasks(const std::function<void(size_t)>& task, size_t taskCount) {
+    size_t index;
+    while ((index = nextTask.fetch_add(1, std::memory_order_relaxed)) < taskCount) {
+        task(index);
+        completedTasks.fetch_add(1, std::memory_order_release);
+    }
+}
@@ -0,0 +1,76 @@
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include <thread>
+#include <vector>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief A fixed set of worker threads that run batches of independent tasks.
+ *
+ * Unlike ThreadManager, which starts one long-lived thread per job, the pool's threads are
+ * created once and sleep between batches, so fanning a frame's work out costs a wake-up rather
+ * than a thread start. The calling thread works on the batch too and returns once every task has
+ * finished. Only one thread at a time may hand batches to the pool.
+ */
+class WorkerPool {
+public:
+    /**
+     * @brief Starts the worker threads.
+     * @param threadCount The number of worker threads, not counting the thread that calls run().
+     */
+    explicit WorkerPool(size_t threadCount);
+
+    /**
+     * @brief Stops and joins the worker threads.
+     */
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    /**
+     * @brief Gets the number of worker threads.
+     * @return The number of threads, not counting the thread that calls run().
+     */
+    size_t getThreadCount() const;
+
+    /**
+     * @brief Runs task(0) .. task(taskCount - 1) across the workers and the calling thread.
+     *
+     * Tasks are handed out one at a time, so uneven tasks balance themselves. Blocks until every
+     * task has finished.
+     *
+     * @param taskCount The number of tasks.
+     * @param task The task to run for each index; called concurrently from several threads.
+     * @param onWait Called now and then on the calling thread while it waits for the workers to
+     *        finish (for example to drain a queue the tasks write to), or an empty function.
+     */
+    void run(size_t taskCount, const std::function<void(size_t)>& task, const std::function<void()>& onWait = std::function<void()>());
+
+private:
+    // Body of each worker thread
+    void workerLoop();
+
+    // Claims and runs tasks of the current batch until none are left
+    void runTasks(const std::function<void(size_t)>& task, size_t taskCount);
+
+    std::vector<std::thread> threads;                  // The worker threads
+    std::mutex mutex;                                  // Guards the batch fields below
+    std::condition_variable wake;                      // Signals a new batch or shutdown to the workers
+    std::condition_variable done;                      // Signals the caller that a worker left the batch
+    const std::function<void(size_t)>* currentTask = nullptr; // Task of the running batch, or nullptr between batches
+    size_t currentTaskCount = 0;                       // Number of tasks in the running batch
+    uint64_t batch = 0;                                // Number of the running batch
+    size_t busyWorkers = 0;                            // Workers currently running tasks of the batch
+    bool stopping = false;                             // Set when the pool is being destroyed
+    std::atomic<size_t> nextTask{ 0 };                 // Index of the next unclaimed task
+    std::atomic<size_t> completedTasks{ 0 };           // Number of finished tasks
+};
+
+#endif // WORKER_POOL_H
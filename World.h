@@ -0,0 +1,45 @@
+#ifndef WORLD_H
+#define WORLD_H
+
+#include "PropertyManager.h"
+#include "EventManager.h"
+
+/**
+ * @brief One independent game session: its objects, their properties and its event bus.
+ *
+ * A World owns its own PropertyManager and EventManager and shares no state with any other World,
+ * so several sessions (matches hosted by one server, headless simulations, benchmarks) can live in
+ * the same process and be stepped on different threads. A single World is not thread-safe; step
+ * each one from one thread at a time.
+ */
+class World {
+public:
+    World() = default;
+    ~World() = default;
+
+    // Worlds own their storages and handlers, so they are neither copied nor moved
+    World(const World&) = delete;
+    World& operator=(const World&) = delete;
+
+    /**
+     * @brief Accessor for the world's property manager.
+     * @return The property manager holding every object in this world.
+     */
+    PropertyManager& getPropertyManager() {
+        return propertyManager;
+    }
+
+    /**
+     * @brief Accessor for the world's event manager.
+     * @return The event manager dispatching this world's events.
+     */
+    EventManager& getEventManager() {
+        return eventManager;
+    }
+
+private:
+    PropertyManager propertyManager; // Objects and their properties
+    EventManager eventManager;       // Event handlers and queued events
+};
+
+#endif // WORLD_H
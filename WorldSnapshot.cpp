@@ -0,0 +1,516 @@
+#include "WorldSnapshot.h"
+#include "PropertyManager.h"
+#include <iostream>
+#include <fstream>
+#include <cstring>
+#include <algorithm>
+#include <type_traits>
+#include <cstddef>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// Every array in the file starts on this boundary so it can be read in place from the mapping
+const size_t SNAPSHOT_ALIGNMENT = 8;
+
+/**
+ * @brief Fixed header at the start of every snapshot file.
+ */
+struct FileHeader {
+    uint32_t magic;             // WorldSnapshot::MAGIC
+    uint32_t formatVersion;     // WorldSnapshot::FORMAT_VERSION
+    uint32_t propertyTypeCount; // PROPERTY_TYPE_COUNT of the build that wrote the file
+    uint32_t slotSize;          // Size of one slot record
+    uint32_t slotCount;         // Number of slot records (and of signatures)
+    uint32_t freeSlotCount;     // Number of entries in the free list
+    uint32_t namedIDCount;      // Number of named object IDs
+    uint32_t storageCount;      // Number of storage blocks that follow
+    uint32_t changeVersion;     // Change version of the manager when it was saved
+    uint32_t layoutVersion;     // Version of the level code that built the saved objects
+};
+
+/**
+ * @brief Header in front of each storage block.
+ */
+struct StorageHeader {
+    uint32_t propertyType;  // PropertyType of the storage
+    uint32_t componentSize; // Size of one component, used to reject mismatched builds
+    uint32_t count;         // Number of packed components
+    uint32_t sparseSize;    // Number of sparse index entries
+};
+
+size_t alignedSize(size_t bytes) {
+    return (bytes + SNAPSHOT_ALIGNMENT - 1) / SNAPSHOT_ALIGNMENT * SNAPSHOT_ALIGNMENT;
+}
+
+// Reserve room for an array at the end of the buffer and return where it starts
+unsigned char* appendArray(std::vector<unsigned char>& buffer, size_t bytes) {
+    size_t offset = buffer.size();
+    buffer.resize(offset + alignedSize(bytes), 0);
+    return buffer.data() + offset;
+}
+
+/**
+ * @brief Bounds-checked cursor over the mapped file.
+ */
+class SnapshotReader {
+public:
+    SnapshotReader(const unsigned char* data, size_t size) : cursor(data), end(data + size) {}
+
+    // Returns the next array of count elements, or nullptr if the file is too short
+    const void* takeArray(size_t count, size_t elementSize) {
+        // Compare by division so a huge count from a corrupt header cannot overflow the byte count
+        if (elementSize != 0 && count > static_cast<size_t>(end - cursor) / elementSize) {
+            return nullptr;
+        }
+        return take(count * elementSize);
+    }
+
+    // Returns the next array of the given size, or nullptr if the file is too short
+    const void* take(size_t bytes) {
+        size_t padded = alignedSize(bytes);
+        if (static_cast<size_t>(end - cursor) < padded) {
+            return nullptr;
+        }
+        const void* result = cursor;
+        cursor += padded;
+        return result;
+    }
+
+private:
+    const unsigned char* cursor; // Next unread byte
+    const unsigned char* end;    // One past the last byte of the file
+};
+
+/**
+ * @brief Read-only memory mapping of a whole file.
+ */
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path) {
+#ifdef _WIN32
+        file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            return;
+        }
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+            return;
+        }
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping) {
+            return;
+        }
+        data = static_cast<const unsigned char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        if (data) {
+            size = static_cast<size_t>(fileSize.QuadPart);
+        }
+#else
+        descriptor = open(path.c_str(), O_RDONLY);
+        if (descriptor < 0) {
+            return;
+        }
+        struct stat info;
+        if (fstat(descriptor, &info) != 0 || info.st_size == 0) {
+            return;
+        }
+        void* mapped = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+        if (mapped != MAP_FAILED) {
+            data = static_cast<const unsigned char*>(mapped);
+            size = static_cast<size_t>(info.st_size);
+        }
+#endif
+    }
+
+    ~MappedFile() {
+#ifdef _WIN32
+        if (data) {
+            UnmapViewOfFile(data);
+        }
+        if (mapping) {
+            CloseHandle(mapping);
+        }
+        if (file != INVALID_HANDLE_VALUE) {
+            CloseHandle(file);
+        }
+#else
+        if (data) {
+            munmap(const_cast<unsigned char*>(data), size);
+        }
+        if (descriptor >= 0) {
+            close(descriptor);
+        }
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const unsigned char* data = nullptr; // Start of the mapped file, or nullptr if mapping failed
+    size_t size = 0;                     // Size of the mapped file in bytes
+
+private:
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#else
+    int descriptor = -1;
+#endif
+};
+
+// Create an empty storage for a property type the snapshot copies as raw bytes
+template <typename T>
+IComponentStorage* createSnapshotStorage() {
+    static_assert(std::is_trivially_copyable<T>::value, "Snapshot properties must be trivially copyable");
+    return createComponentStorage<T>();
+}
+
+// Create an empty storage for a property type read from a file
+IComponentStorage* createStorage(PropertyType type) {
+    switch (type) {
+    case RECT_PROPERTY:      return createSnapshotStorage<RectProperty>();
+    case RENDER_PROPERTY:    return createSnapshotStorage<RenderProperty>();
+    case PHYSICS_PROPERTY:   return createSnapshotStorage<PhysicsProperty>();
+    case COLLISION_PROPERTY: return createSnapshotStorage<CollisionProperty>();
+    case VELOCITY_PROPERTY:  return createSnapshotStorage<VelocityProperty>();
+    case INPUT_PROPERTY:     return createSnapshotStorage<InputProperty>();
+    case SCROLLING_PROPERTY: return createSnapshotStorage<ScrollingProperty>();
+    default:                 return nullptr;
+    }
+}
+
+/**
+ * @brief Pointers into the mapped file for one storage block.
+ */
+struct StorageBlock {
+    const StorageHeader* header;
+    const void* components;
+    const int* objectIDs;
+    const uint32_t* versions;
+    const int* sparse;
+};
+
+// Sparse entry of a slot without a component (ComponentStorage's INVALID_INDEX)
+const int EMPTY_SPARSE_ENTRY = -1;
+
+// The checks below take PropertyManager's private slot type as a template parameter, which
+// WorldSnapshot (a friend) supplies
+
+// Check that an ID names a live object of the slot table
+template <typename Slot>
+bool isLiveID(int objectID, const Slot* slots, size_t slotCount) {
+    if (objectID < 0) {
+        return false;
+    }
+    size_t index = static_cast<size_t>(Entity::getIndex(objectID));
+    return index < slotCount && slots[index].alive && slots[index].generation == Entity::getGeneration(objectID);
+}
+
+// Check the slot table, free list and named IDs read from a file
+template <typename Slot>
+bool isValidSlotTable(const Slot* slots, size_t slotCount, const int* freeSlots, size_t freeSlotCount,
+    const int* namedIDs, size_t namedIDCount) {
+    if (slotCount > static_cast<size_t>(Entity::INDEX_MASK) + 1) {
+        return false;
+    }
+    for (size_t i = 0; i < slotCount; ++i) {
+        // Read the flag as a byte; a bool holding anything but 0 or 1 must not be looked at as a bool
+        unsigned char alive;
+        std::memcpy(&alive, reinterpret_cast<const unsigned char*>(&slots[i]) + offsetof(Slot, alive), 1);
+        if (slots[i].generation < 0 || slots[i].generation > Entity::GENERATION_MASK || alive > 1) {
+            return false;
+        }
+    }
+
+    // Each free slot must be dead and listed once, or createObject() would hand it out twice
+    std::vector<bool> listed(slotCount, false);
+    for (size_t i = 0; i < freeSlotCount; ++i) {
+        int index = freeSlots[i];
+        if (index < 0 || static_cast<size_t>(index) >= slotCount || slots[index].alive || listed[index]) {
+            return false;
+        }
+        listed[index] = true;
+    }
+
+    for (size_t i = 0; i < namedIDCount; ++i) {
+        if (namedIDs[i] != Entity::INVALID_ID && !isLiveID(namedIDs[i], slots, slotCount)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Check that a storage block's dense and sparse arrays agree with each other and with the slot
+// table, and note which slots hold a component of its type
+template <typename Slot>
+bool isValidStorage(const StorageBlock& block, const Slot* slots, size_t slotCount,
+    std::vector<PropertySignature>& heldTypes) {
+    size_t count = block.header->count;
+    size_t sparseSize = block.header->sparseSize;
+    PropertySignature typeBit = PropertySignature(1) << block.header->propertyType;
+    if (count > slotCount || sparseSize > static_cast<size_t>(Entity::INDEX_MASK) + 1) {
+        return false;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        int objectID = block.objectIDs[i];
+        if (!isLiveID(objectID, slots, slotCount)) {
+            return false;
+        }
+        size_t index = static_cast<size_t>(Entity::getIndex(objectID));
+        if (index >= sparseSize || block.sparse[index] != static_cast<int>(i)) {
+            return false;
+        }
+        heldTypes[index] |= typeBit;
+    }
+    for (size_t i = 0; i < sparseSize; ++i) {
+        int entry = block.sparse[i];
+        if (entry != EMPTY_SPARSE_ENTRY && (entry < 0 || static_cast<size_t>(entry) >= count
+            || static_cast<size_t>(Entity::getIndex(block.objectIDs[entry])) != i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Generation a slot of the live manager hands out next
+template <typename Slot>
+int nextGeneration(const Slot& slot) {
+    // Destroying an object already bumps its slot; a live object's ID must stop resolving too
+    return slot.alive ? (slot.generation + 1) & Entity::GENERATION_MASK : slot.generation;
+}
+
+// Give an ID from the file the generation its slot has after loading
+int renumberID(int objectID, const std::vector<int>& generations) {
+    if (objectID == Entity::INVALID_ID) {
+        return objectID;
+    }
+    int index = Entity::getIndex(objectID);
+    return Entity::makeID(index, generations[index]);
+}
+
+} // namespace
+
+// Write the full state of a PropertyManager to a file
+bool WorldSnapshot::save(const PropertyManager& propertyManager, const std::string& path, const std::vector<int>& namedIDs, uint32_t layoutVersion) {
+    typedef PropertyManager::Slot Slot;
+
+    FileHeader header = {};
+    header.magic = MAGIC;
+    header.formatVersion = FORMAT_VERSION;
+    header.propertyTypeCount = PROPERTY_TYPE_COUNT;
+    header.slotSize = sizeof(Slot);
+    header.slotCount = static_cast<uint32_t>(propertyManager.slots.size());
+    header.freeSlotCount = static_cast<uint32_t>(propertyManager.freeSlotCount);
+    header.namedIDCount = static_cast<uint32_t>(namedIDs.size());
+    header.changeVersion = propertyManager.changeVersion;
+    header.layoutVersion = layoutVersion;
+    for (const auto& storage : propertyManager.storages) {
+        if (storage && storage->size() > 0) {
+            ++header.storageCount;
+        }
+    }
+
+    // Lay the whole file out in memory so it can be written with a single call
+    std::vector<unsigned char> buffer;
+    std::memcpy(appendArray(buffer, sizeof(header)), &header, sizeof(header));
+    std::copy(propertyManager.slots.begin(), propertyManager.slots.end(),
+        reinterpret_cast<Slot*>(appendArray(buffer, propertyManager.slots.size() * sizeof(Slot))));
+    std::copy(propertyManager.signatures.begin(), propertyManager.signatures.end(),
+        reinterpret_cast<PropertySignature*>(appendArray(buffer, propertyManager.signatures.size() * sizeof(PropertySignature))));
+    int* freeSlots = reinterpret_cast<int*>(appendArray(buffer, header.freeSlotCount * sizeof(int)));
+    for (size_t i = 0; i < propertyManager.freeSlotCount; ++i) {
+        // The free list is a ring; write it out oldest first
+        freeSlots[i] = propertyManager.freeSlots[(propertyManager.freeSlotHead + i) % propertyManager.freeSlots.size()];
+    }
+    std::copy(namedIDs.begin(), namedIDs.end(),
+        reinterpret_cast<int*>(appendArray(buffer, namedIDs.size() * sizeof(int))));
+
+    for (size_t type = 0; type < propertyManager.storages.size(); ++type) {
+        const IComponentStorage* storage = propertyManager.storages[type].get();
+        if (!storage || storage->size() == 0) {
+            continue;
+        }
+
+        StorageHeader storageHeader;
+        storageHeader.propertyType = static_cast<uint32_t>(type);
+        storageHeader.componentSize = static_cast<uint32_t>(storage->getComponentSize());
+        storageHeader.count = static_cast<uint32_t>(storage->size());
+        storageHeader.sparseSize = static_cast<uint32_t>(storage->getSparseSize());
+        std::memcpy(appendArray(buffer, sizeof(storageHeader)), &storageHeader, sizeof(storageHeader));
+
+        // Reserve every array first; appending reallocates the buffer and would move earlier pointers
+        size_t componentsOffset = appendArray(buffer, storageHeader.count * storageHeader.componentSize) - buffer.data();
+        size_t objectIDsOffset = appendArray(buffer, storageHeader.count * sizeof(int)) - buffer.data();
+        size_t versionsOffset = appendArray(buffer, storageHeader.count * sizeof(uint32_t)) - buffer.data();
+        size_t sparseOffset = appendArray(buffer, storageHeader.sparseSize * sizeof(int)) - buffer.data();
+        storage->copyRaw(buffer.data() + componentsOffset,
+            reinterpret_cast<int*>(buffer.data() + objectIDsOffset),
+            reinterpret_cast<uint32_t*>(buffer.data() + versionsOffset),
+            reinterpret_cast<int*>(buffer.data() + sparseOffset));
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        std::cerr << "Failed to open world snapshot for writing: " << path << std::endl;
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+    if (!file) {
+        std::cerr << "Failed to write world snapshot: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Replace the full state of a PropertyManager with the contents of a file
+bool WorldSnapshot::load(PropertyManager& propertyManager, const std::string& path, std::vector<int>& namedIDs, uint32_t layoutVersion) {
+    typedef PropertyManager::Slot Slot;
+
+    MappedFile file(path);
+    if (!file.data) {
+        return false;  // A missing snapshot is not an error; callers fall back to building the world
+    }
+
+    // Validate the whole file before touching the manager so a bad file leaves it unchanged
+    SnapshotReader reader(file.data, file.size);
+    const FileHeader* header = static_cast<const FileHeader*>(reader.take(sizeof(FileHeader)));
+    if (!header || header->magic != MAGIC || header->formatVersion != FORMAT_VERSION
+        || header->propertyTypeCount != PROPERTY_TYPE_COUNT || header->slotSize != sizeof(Slot)) {
+        std::cerr << "Incompatible world snapshot: " << path << std::endl;
+        return false;
+    }
+    if (header->layoutVersion != layoutVersion) {
+        std::cerr << "Out-of-date world snapshot: " << path << std::endl;
+        return false;  // Written by older level code; the caller rebuilds the level and saves it again
+    }
+
+    size_t slotCount = header->slotCount;
+    const Slot* slots = static_cast<const Slot*>(reader.takeArray(slotCount, sizeof(Slot)));
+    const PropertySignature* signatures = static_cast<const PropertySignature*>(reader.takeArray(slotCount, sizeof(PropertySignature)));
+    const int* freeSlots = static_cast<const int*>(reader.takeArray(header->freeSlotCount, sizeof(int)));
+    const int* storedNamedIDs = static_cast<const int*>(reader.takeArray(header->namedIDCount, sizeof(int)));
+    if (!slots || !signatures || !freeSlots || !storedNamedIDs || header->storageCount > PROPERTY_TYPE_COUNT
+        || !isValidSlotTable(slots, slotCount, freeSlots, header->freeSlotCount, storedNamedIDs, header->namedIDCount)) {
+        std::cerr << "Corrupt world snapshot: " << path << std::endl;
+        return false;
+    }
+
+    StorageBlock blocks[PROPERTY_TYPE_COUNT];
+    std::vector<PropertySignature> heldTypes(slotCount, 0);  // Storages each slot turned out to be in
+    PropertySignature storedTypes = 0;
+    for (uint32_t i = 0; i < header->storageCount; ++i) {
+        StorageBlock& block = blocks[i];
+        block.header = static_cast<const StorageHeader*>(reader.take(sizeof(StorageHeader)));
+        if (!block.header || block.header->propertyType >= PROPERTY_TYPE_COUNT
+            || (storedTypes & (PropertySignature(1) << block.header->propertyType))) {
+            std::cerr << "Corrupt world snapshot: " << path << std::endl;
+            return false;
+        }
+        storedTypes |= PropertySignature(1) << block.header->propertyType;
+
+        // Compare against the storage this build would use for the type
+        std::unique_ptr<IComponentStorage> expected(createStorage(static_cast<PropertyType>(block.header->propertyType)));
+        if (!expected || expected->getComponentSize() != block.header->componentSize) {
+            std::cerr << "Incompatible world snapshot: " << path << std::endl;
+            return false;
+        }
+
+        block.components = reader.takeArray(block.header->count, block.header->componentSize);
+        block.objectIDs = static_cast<const int*>(reader.takeArray(block.header->count, sizeof(int)));
+        block.versions = static_cast<const uint32_t*>(reader.takeArray(block.header->count, sizeof(uint32_t)));
+        block.sparse = static_cast<const int*>(reader.takeArray(block.header->sparseSize, sizeof(int)));
+        if (!block.components || !block.objectIDs || !block.versions || !block.sparse
+            || !isValidStorage(block, slots, slotCount, heldTypes)) {
+            std::cerr << "Corrupt world snapshot: " << path << std::endl;
+            return false;
+        }
+    }
+
+    // Views trust the signatures, so they must name exactly the storages each object is in
+    for (size_t i = 0; i < slotCount; ++i) {
+        if (signatures[i] != heldTypes[i]) {
+            std::cerr << "Corrupt world snapshot: " << path << std::endl;
+            return false;
+        }
+    }
+
+    // Every slot carries on from the generation it has in the manager now instead of the one in the
+    // file, so no ID handed out before the load (and no event still queued about it) resolves afterwards
+    std::vector<Slot>& liveSlots = propertyManager.slots;
+    size_t liveSlotCount = liveSlots.size();
+    std::vector<int> generations(slotCount);
+    for (size_t i = 0; i < slotCount; ++i) {
+        generations[i] = i < liveSlotCount ? nextGeneration(liveSlots[i]) : slots[i].generation;
+    }
+    std::vector<Slot> retiredSlots;  // Live slots past the end of the file, kept free so their generations survive
+    for (size_t i = slotCount; i < liveSlotCount; ++i) {
+        Slot slot;
+        slot.generation = nextGeneration(liveSlots[i]);
+        retiredSlots.push_back(slot);
+    }
+
+    // Copy each array into place in one go, then renumber the generations
+    liveSlots.assign(slots, slots + slotCount);
+    for (size_t i = 0; i < slotCount; ++i) {
+        liveSlots[i].generation = generations[i];
+    }
+    liveSlots.insert(liveSlots.end(), retiredSlots.begin(), retiredSlots.end());
+    propertyManager.signatures.assign(signatures, signatures + slotCount);
+    propertyManager.signatures.resize(liveSlots.size(), 0);
+    // Keep the free ring at least as large as before, so a reserved manager stays free of allocations
+    size_t freeSlotCount = header->freeSlotCount + retiredSlots.size();
+    if (propertyManager.freeSlots.size() < freeSlotCount) {
+        propertyManager.freeSlots.resize(freeSlotCount);
+    }
+    std::copy(freeSlots, freeSlots + header->freeSlotCount, propertyManager.freeSlots.begin());
+    for (size_t i = slotCount; i < liveSlots.size(); ++i) {
+        propertyManager.freeSlots[header->freeSlotCount + (i - slotCount)] = static_cast<int>(i);
+    }
+    propertyManager.freeSlotHead = 0;
+    propertyManager.freeSlotCount = freeSlotCount;
+    // A load counts as a change of every loaded component. The counter only moves forward, so
+    // versions captured before the load stay behind every component stamped by it.
+    uint32_t loadVersion = std::max(propertyManager.changeVersion, header->changeVersion) + 1;
+    propertyManager.changeVersion = loadVersion;
+    propertyManager.commandBuffer.clear();
+
+    namedIDs.resize(header->namedIDCount);
+    for (size_t i = 0; i < namedIDs.size(); ++i) {
+        namedIDs[i] = renumberID(storedNamedIDs[i], generations);
+    }
+
+    for (auto& storage : propertyManager.storages) {
+        if (storage) {
+            storage->assignRaw(nullptr, nullptr, nullptr, 0, nullptr, 0);
+        }
+    }
+    std::vector<int> objectIDs;
+    std::vector<uint32_t> versions;
+    for (uint32_t i = 0; i < header->storageCount; ++i) {
+        const StorageBlock& block = blocks[i];
+        std::unique_ptr<IComponentStorage>& storage = propertyManager.storages[block.header->propertyType];
+        if (!storage) {
+            storage.reset(createStorage(static_cast<PropertyType>(block.header->propertyType)));
+        }
+        objectIDs.resize(block.header->count);
+        for (size_t j = 0; j < objectIDs.size(); ++j) {
+            objectIDs[j] = renumberID(block.objectIDs[j], generations);
+        }
+        versions.assign(block.header->count, loadVersion);
+        storage->assignRaw(block.components, objectIDs.data(), versions.data(), block.header->count,
+            block.sparse, block.header->sparseSize);
+    }
+    return true;
+}
@@ -0,0 +1,62 @@
+#ifndef WORLD_SNAPSHOT_H
+#define WORLD_SNAPSHOT_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+class PropertyManager;
+
+/**
+ * @brief Saves and loads the complete PropertyManager state as a compact binary file.
+ *
+ * The file is a fixed header followed by the raw slot table, the slot signatures, the free list,
+ * a list of named object IDs supplied by the caller, and one block per non-empty property storage
+ * holding its packed component, object ID and version arrays plus its sparse index. Every array is written exactly as
+ * it is laid out in memory and padded to an 8-byte boundary, so loading maps the file and copies
+ * each array into place with a single bulk copy instead of parsing objects one by one.
+ *
+ * The format is tied to the in-memory layout of the properties. The header records the format
+ * version and the number of property types, and every storage block records its component size,
+ * so a file written by an incompatible build is rejected rather than misread. The header also records
+ * a layout version chosen by the game, so a file saved before the level code changed is rejected too.
+ * Before anything is copied, every index in the file is checked against the slot table and the
+ * storage sizes, so a truncated or corrupt file cannot plant out-of-range indices in the manager.
+ */
+class WorldSnapshot {
+public:
+    static const uint32_t MAGIC = 0x50534E57;   // "WNSP" in file byte order on little-endian machines
+    static const uint32_t FORMAT_VERSION = 3; // Bump whenever the layout of the file or of a property changes
+
+    /**
+     * @brief Write the full state of a PropertyManager to a file.
+     * @param propertyManager The manager to save.
+     * @param path The file to write.
+     * @param namedIDs Object IDs the game needs to find again after loading (player, spawn point, ...).
+     * @param layoutVersion Version of the code that built the level; load() rejects files saved with another one.
+     * @return True if the file was written, false otherwise.
+     */
+    static bool save(const PropertyManager& propertyManager, const std::string& path, const std::vector<int>& namedIDs,
+        uint32_t layoutVersion);
+
+    /**
+     * @brief Replace the full state of a PropertyManager with the contents of a file.
+     *
+     * Every object ID obtained before loading is invalidated: slots keep counting generations from
+     * where the manager had them rather than from the file, so loading the same file twice never hands
+     * out an ID that an earlier object (or an event still queued about it) had. Use the returned named
+     * IDs to find objects again. Every loaded property counts as changed, so a version captured
+     * with PropertyManager::captureVersion() before the load reports all of them. On failure the
+     * manager is left unchanged.
+     *
+     * @param propertyManager The manager to load into.
+     * @param path The file to read.
+     * @param namedIDs Receives the named object IDs stored with the snapshot.
+     * @param layoutVersion Version of the code that builds the level; a file saved with another one is out of date.
+     * @return True if the snapshot was loaded, false if the file is missing, out of date, incompatible or corrupt.
+     */
+    static bool load(PropertyManager& propertyManager, const std::string& path, std::vector<int>& namedIDs,
+        uint32_t layoutVersion);
+};
+
+#endif // WORLD_SNAPSHOT_H
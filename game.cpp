@@ -1,5 +1,6 @@
 #include "game.h"
 #include "PropertyManager.h" // For property-based model
+#include "WorldSnapshot.h"
 #include "ThreadManager.h"
 #include <iostream>
 #include <cstring>
@@ -11,8 +12,8 @@
 
 
 // Constructor for the Game class
-Game::Game(SDL_Renderer* renderer, zmq::socket_t& reqSocket, zmq::socket_t& subSocket, zmq::socket_t& eventReqSocket)
-    : renderer(renderer), reqSocket(reqSocket), subSocket(subSocket), eventReqSocket(eventReqSocket), quit(false), clientId(-1), cameraX(0), cameraY(0), gameTimeline(nullptr, 1.0f)
+Game::Game(World& world, SDL_Renderer* renderer, zmq::socket_t& reqSocket, zmq::socket_t& subSocket, NetworkEventBus& eventBus)
+    : world(world), renderer(renderer), reqSocket(reqSocket), subSocket(subSocket), eventBus(eventBus), quit(false), clientId(-1), cameraX(0), cameraY(0), lastSentVersion(0), lastSentPosition{ 0, 0 }, respawnPending(false), gameTimeline(nullptr, 1.0f)
 {
     // Initialize game objects, such as players, platforms, etc.
     initGameObjects();
@@ -23,90 +24,133 @@ Game::~Game() {}
 
 // Initialize game objects (characters, platforms, etc.)
 void Game::initGameObjects() {
-    auto& propertyManager = PropertyManager::getInstance();
-    auto& eventManager = EventManager::getInstance();
+    auto& propertyManager = world.getPropertyManager();
+    auto& eventManager = world.getEventManager();
+
+    // Handle each input action and each player-platform contact once per frame, however often it is raised
+    eventManager.setCoalescing(INPUT, true);
+    eventManager.setCoalescing(COLLISION, true);
 
     // Register event handlers
-    eventManager.registerHandler(INPUT, [this](std::shared_ptr<Event> event) {
-        auto inputEvent = std::static_pointer_cast<InputEvent>(event);
-        handleInput(inputEvent->getObjectID(), inputEvent->getInputAction());
+    inputSubscription = eventManager.subscribe(INPUT, [this](const Event& event) {
+        InputEvent inputEvent(event);
+        handleInput(inputEvent.getObjectID(), inputEvent.getInputAction());
+    });
+
+    collisionSubscription = eventManager.subscribe(COLLISION, [this](const Event& event) {
+        CollisionEvent collisionEvent(event);
+        resolveCollision(collisionEvent.getObject1ID(), collisionEvent.getObject2ID());
     });
 
-    eventManager.registerHandler(COLLISION, [this](std::shared_ptr<Event> event) {
-        auto collisionEvent = std::static_pointer_cast<CollisionEvent>(event);
-        resolveCollision(collisionEvent->getObject1ID(), collisionEvent->getObject2ID());
+    deathSubscription = eventManager.subscribe(DEATH, [this](const Event& event) {
+        DeathEvent deathEvent(event);
+        handleDeath(deathEvent.getObjectID());
     });
 
-    eventManager.registerHandler(DEATH, [this](std::shared_ptr<Event> event) {
-        auto deathEvent = std::static_pointer_cast<DeathEvent>(event);
-        handleDeath(deathEvent->getObjectID());
+    spawnSubscription = eventManager.subscribe(SPAWN, [this](const Event& event) {
+        SpawnEvent spawnEvent(event);
+        handleSpawn(spawnEvent.getObjectID());
     });
 
-    eventManager.registerHandler(SPAWN, [this](std::shared_ptr<Event> event) {
-        auto spawnEvent = std::static_pointer_cast<SpawnEvent>(event);
-        handleSpawn(spawnEvent->getObjectID());
+    // Share deaths and spawns with the other clients; their player positions already arrive from the server
+    eventManager.setReplicated(DEATH, true);
+    eventManager.setReplicated(SPAWN, true);
+
+    // Hide another client's player between its death and its respawn
+    remoteDeathSubscription = eventManager.subscribeRemote(DEATH, [this](const Event& event) {
+        deadPlayers.insert(event.getSource());
     });
 
+    remoteSpawnSubscription = eventManager.subscribeRemote(SPAWN, [this](const Event& event) {
+        deadPlayers.erase(event.getSource());
+    });
+
+    // Load the level from its snapshot; build it from scratch (and write the snapshot) on first run
+    int* namedObjects[] = { &playerID, &platformID, &platformID2, &platformID3, &movingPlatformID, &movingPlatformID2,
+        &spawnPointID, &deathZoneID, &rightBoundaryID, &leftBoundaryID };
+    const size_t namedObjectCount = sizeof(namedObjects) / sizeof(namedObjects[0]);
+    std::vector<int> namedIDs;
+
+    if (WorldSnapshot::load(propertyManager, PLATFORMER_WORLD_FILE, namedIDs, PLATFORMER_LAYOUT_VERSION) && namedIDs.size() == namedObjectCount) {
+        for (size_t i = 0; i < namedObjectCount; ++i) {
+            *namedObjects[i] = namedIDs[i];
+        }
+    }
+    else {
+        createLevelObjects();
+        namedIDs.clear();
+        for (size_t i = 0; i < namedObjectCount; ++i) {
+            namedIDs.push_back(*namedObjects[i]);
+        }
+        WorldSnapshot::save(propertyManager, PLATFORMER_WORLD_FILE, namedIDs, PLATFORMER_LAYOUT_VERSION);
+    }
+
+    rightScrollCount = 0;
+    leftScrollCount = 0;
+}
+
+// Create the level's objects (characters, platforms, etc.) property by property
+void Game::createLevelObjects() {
+    auto& propertyManager = world.getPropertyManager();
+
     // Create player object and set its properties (position, render color, physics, etc.)
     playerID = propertyManager.createObject();
-    propertyManager.addProperty(playerID, "Rect", std::make_shared<RectProperty>(100, 400, 50, 50));
-    propertyManager.addProperty(playerID, "Render", std::make_shared<RenderProperty>(255, 0, 0)); // Red color for player
-    propertyManager.addProperty(playerID, "Physics", std::make_shared<PhysicsProperty>(10));  // Gravity
-    propertyManager.addProperty(playerID, "Collision", std::make_shared<CollisionProperty>(true)); // Enable collision
-    propertyManager.addProperty(playerID, "Velocity", std::make_shared<VelocityProperty>(0, 0)); // Initial velocity
-	propertyManager.addProperty(playerID, "Input", std::make_shared<InputProperty>(true, false)); // Input property
+    propertyManager.addProperty(playerID, RectProperty(100, 400, 50, 50));
+    propertyManager.addProperty(playerID, RenderProperty(255, 0, 0)); // Red color for player
+    propertyManager.addProperty(playerID, PhysicsProperty(10));  // Gravity
+    propertyManager.addProperty(playerID, CollisionProperty(true)); // Enable collision
+    propertyManager.addProperty(playerID, VelocityProperty(0, 0)); // Initial velocity
+	propertyManager.addProperty(playerID, InputProperty(true, false)); // Input property
 
     // Create static platforms with different sizes and positions
     platformID = propertyManager.createObject();
-    propertyManager.addProperty(platformID, "Rect", std::make_shared<RectProperty>(50, 500, 200, 50));
-    propertyManager.addProperty(platformID, "Render", std::make_shared<RenderProperty>(128, 0, 128)); // Purple color
-    propertyManager.addProperty(platformID, "Collision", std::make_shared<CollisionProperty>(true));
+    propertyManager.addProperty(platformID, RectProperty(50, 500, 200, 50));
+    propertyManager.addProperty(platformID, RenderProperty(128, 0, 128)); // Purple color
+    propertyManager.addProperty(platformID, CollisionProperty(true));
 
     platformID2 = propertyManager.createObject();
-    propertyManager.addProperty(platformID2, "Rect", std::make_shared<RectProperty>(250, 600, 200, 50));
-    propertyManager.addProperty(platformID2, "Render", std::make_shared<RenderProperty>(255, 255, 0)); // Yellow color
-    propertyManager.addProperty(platformID2, "Collision", std::make_shared<CollisionProperty>(true));
+    propertyManager.addProperty(platformID2, RectProperty(250, 600, 200, 50));
+    propertyManager.addProperty(platformID2, RenderProperty(255, 255, 0)); // Yellow color
+    propertyManager.addProperty(platformID2, CollisionProperty(true));
 
     platformID3 = propertyManager.createObject();
-    propertyManager.addProperty(platformID3, "Rect", std::make_shared<RectProperty>(450, 700, 900, 50));
-    propertyManager.addProperty(platformID3, "Render", std::make_shared<RenderProperty>(50, 50, 50)); // Gray color
-    propertyManager.addProperty(platformID3, "Collision", std::make_shared<CollisionProperty>(true));
+    propertyManager.addProperty(platformID3, RectProperty(450, 700, 900, 50));
+    propertyManager.addProperty(platformID3, RenderProperty(50, 50, 50)); // Gray color
+    propertyManager.addProperty(platformID3, CollisionProperty(true));
 
     // Create a horizontally moving platform
     movingPlatformID = propertyManager.createObject();
-    propertyManager.addProperty(movingPlatformID, "Rect", std::make_shared<RectProperty>(150, 900, 200, 50));
-    propertyManager.addProperty(movingPlatformID, "Render", std::make_shared<RenderProperty>(255, 255, 0)); // Yellow color
-    propertyManager.addProperty(movingPlatformID, "Collision", std::make_shared<CollisionProperty>(true));
-    propertyManager.addProperty(movingPlatformID, "Velocity", std::make_shared<VelocityProperty>(2, 0));  // Moving horizontally
+    propertyManager.addProperty(movingPlatformID, RectProperty(150, 900, 200, 50));
+    propertyManager.addProperty(movingPlatformID, RenderProperty(255, 255, 0)); // Yellow color
+    propertyManager.addProperty(movingPlatformID, CollisionProperty(true));
+    propertyManager.addProperty(movingPlatformID, VelocityProperty(2, 0));  // Moving horizontally
     std::cout << "Moving Platform 1 Velocity initialized" << std::endl;
 
     // Create a vertically moving platform
     movingPlatformID2 = propertyManager.createObject();
-    propertyManager.addProperty(movingPlatformID2, "Rect", std::make_shared<RectProperty>(1400, 200, 200, 50));  // Different position
-    propertyManager.addProperty(movingPlatformID2, "Render", std::make_shared<RenderProperty>(255, 165, 0));  // Orange color
-    propertyManager.addProperty(movingPlatformID2, "Collision", std::make_shared<CollisionProperty>(true));
-    propertyManager.addProperty(movingPlatformID2, "Velocity", std::make_shared<VelocityProperty>(0, 2));  // Moving vertically
+    propertyManager.addProperty(movingPlatformID2, RectProperty(1400, 200, 200, 50));  // Different position
+    propertyManager.addProperty(movingPlatformID2, RenderProperty(255, 165, 0));  // Orange color
+    propertyManager.addProperty(movingPlatformID2, CollisionProperty(true));
+    propertyManager.addProperty(movingPlatformID2, VelocityProperty(0, 2));  // Moving vertically
     std::cout << "Moving Platform 2 Velocity initialized" << std::endl;
 
     // Create a spawn point for the player
     spawnPointID = propertyManager.createObject();
-    propertyManager.addProperty(spawnPointID, "Rect", std::make_shared<RectProperty>(100, 450, 50, 50));
+    propertyManager.addProperty(spawnPointID, RectProperty(100, 450, 50, 50));
 
     // Create a death zone at the bottom of the screen
     deathZoneID = propertyManager.createObject();
-    propertyManager.addProperty(deathZoneID, "Rect", std::make_shared<RectProperty>(0, SCREEN_HEIGHT - 50, SCREEN_WIDTH, 50));  // Near the bottom
-    propertyManager.addProperty(deathZoneID, "Collision", std::make_shared<CollisionProperty>(true));  // Enable collision for the death zone
+    propertyManager.addProperty(deathZoneID, RectProperty(0, SCREEN_HEIGHT - 50, SCREEN_WIDTH, 50));  // Near the bottom
+    propertyManager.addProperty(deathZoneID, CollisionProperty(true));  // Enable collision for the death zone
 
     // Create screen boundaries (left and right)
     rightBoundaryID = propertyManager.createObject();
-    propertyManager.addProperty(rightBoundaryID, "Rect", std::make_shared<RectProperty>(SCREEN_WIDTH - 50, 0, 50, SCREEN_HEIGHT));
-    propertyManager.addProperty(rightBoundaryID, "Collision", std::make_shared<CollisionProperty>(true));
-    rightScrollCount = 0;
+    propertyManager.addProperty(rightBoundaryID, RectProperty(SCREEN_WIDTH - 50, 0, 50, SCREEN_HEIGHT));
+    propertyManager.addProperty(rightBoundaryID, CollisionProperty(true));
 
     leftBoundaryID = propertyManager.createObject();
-    propertyManager.addProperty(leftBoundaryID, "Rect", std::make_shared<RectProperty>(0, 0, 50, SCREEN_HEIGHT));
-    propertyManager.addProperty(leftBoundaryID, "Collision", std::make_shared<CollisionProperty>(true));
-    leftScrollCount = 0;
+    propertyManager.addProperty(leftBoundaryID, RectProperty(0, 0, 50, SCREEN_HEIGHT));
+    propertyManager.addProperty(leftBoundaryID, CollisionProperty(true));
 }
 
 // Main game loop
@@ -115,8 +159,11 @@ void Game::run() {
     while (!quit) {
         handleEvents();  // Handle input and events
         receivePlayerPositions();  // Receive other players' positions from the server
-        EventManager::getInstance().dispatchEvents();
+        eventBus.receive();  // Raise the events other clients replicated since the last frame
+        world.getEventManager().dispatchEvents(gameTimeline.getTime());
+        sendMovementUpdate();  // Send the position once this frame's collisions are resolved
         update();  // Update the game state (e.g., player movement, collision detection)
+        eventBus.send();  // Send this frame's deaths and spawns to the other clients in one batch
         render();  // Render the game objects to the screen
 
         // Cap frame rate to around 60 FPS
@@ -124,6 +171,17 @@ void Game::run() {
     }
 }
 
+// Play back a recorded session
+void Game::replay(EventJournalReader& reader) {
+    uint64_t frames = 0;
+    int64_t frameTime = 0;
+    while (world.getEventManager().replayFrame(reader, frameTime)) {
+        update();  // Step the game between frames, as run() does after dispatching
+        ++frames;
+    }
+    std::cout << "Replayed " << frames << " frames" << std::endl;
+}
+
 // Handle events, including input
 void Game::handleEvents() {
     while (SDL_PollEvent(&e) != 0) {
@@ -133,30 +191,28 @@ void Game::handleEvents() {
     }
 
     // Handle input for the local player
-    auto& propertyManager = PropertyManager::getInstance();
-    std::shared_ptr<RectProperty> playerRect = std::static_pointer_cast<RectProperty>(propertyManager.getProperty(playerID, "Rect"));
-    std::shared_ptr<VelocityProperty> playerVel = std::static_pointer_cast<VelocityProperty>(propertyManager.getProperty(playerID, "Velocity"));
+    auto& propertyManager = world.getPropertyManager();
+    RectProperty* playerRect = propertyManager.getProperty<RectProperty>(playerID);
+    VelocityProperty* playerVel = propertyManager.getProperty<VelocityProperty>(playerID);
 
     // Handle keyboard input for player movement
     const Uint8* keystates = SDL_GetKeyboardState(NULL);
 
     if (keystates[SDL_SCANCODE_LEFT]) {
-        EventManager::getInstance().raiseEvent(std::make_shared<InputEvent>(playerID, MOVE_LEFT, &gameTimeline));
+        world.getEventManager().raiseEvent(InputEvent(playerID, MOVE_LEFT, &gameTimeline));
     }
     else if (keystates[SDL_SCANCODE_RIGHT]) {
-        EventManager::getInstance().raiseEvent(std::make_shared<InputEvent>(playerID, MOVE_RIGHT, &gameTimeline));
+        world.getEventManager().raiseEvent(InputEvent(playerID, MOVE_RIGHT, &gameTimeline));
     }
-    else {
-        EventManager::getInstance().raiseEvent(std::make_shared<InputEvent>(playerID, STOP, &gameTimeline));
+    else if (playerVel->vx != 0) {
+        // Only stop a moving player; an idle player raises no events
+        world.getEventManager().raiseEvent(InputEvent(playerID, STOP, &gameTimeline));
     }
 
     if (keystates[SDL_SCANCODE_UP] && playerVel->vy == 1) {
-        EventManager::getInstance().raiseEvent(std::make_shared<InputEvent>(playerID, JUMP, &gameTimeline));
+        world.getEventManager().raiseEvent(InputEvent(playerID, JUMP, &gameTimeline));
     }
 
-    // Send the player's movement update to the server
-    sendMovementUpdate();
-
     // Update camera to follow the player
     updateCamera();
 }
@@ -165,7 +221,9 @@ void Game::handleEvents() {
 void Game::handleDeath(int objectID) {
     std::cout << "Death event triggered for object ID: " << objectID << std::endl;
 
-    EventManager::getInstance().raiseEvent(std::make_shared<SpawnEvent>(objectID, &gameTimeline));
+    // Respawn after a short delay; until then further deaths are ignored
+    respawnPending = true;
+    world.getEventManager().scheduleEvent(SpawnEvent(objectID, &gameTimeline), RESPAWN_DELAY_MS);
 }
 
 void Game::handleSpawn(int objectID) {
@@ -173,53 +231,28 @@ void Game::handleSpawn(int objectID) {
     std::cout << "Spawn event triggered for object ID: " << objectID << std::endl;
     // Code to handle spawning
 
-    auto& propertyManager = PropertyManager::getInstance();
-    auto playerRect = std::static_pointer_cast<RectProperty>(propertyManager.getProperty(objectID, "Rect"));
-    auto playerVel = std::static_pointer_cast<VelocityProperty>(propertyManager.getProperty(objectID, "Velocity"));
-    auto spawnpointRect = std::static_pointer_cast<RectProperty>(propertyManager.getProperty(spawnPointID, "Rect"));
-
-	SpawnEventData spawnData = sendSpawnEvent(objectID, spawnpointRect->x, spawnpointRect->y); // Send spawn event to server
+    auto& propertyManager = world.getPropertyManager();
+    auto playerRect = propertyManager.getProperty<RectProperty>(objectID);
+    auto playerVel = propertyManager.getProperty<VelocityProperty>(objectID);
+    auto spawnpointRect = propertyManager.getProperty<RectProperty>(spawnPointID);
 
-	// Reset player position to a spawnpoint based on the server response
-    playerRect->x = spawnData.spawnX;
-    playerRect->y = spawnData.spawnY;
+    // Reset player position to the spawnpoint; the SPAWN event itself reaches the other clients through the event bus
+    playerRect->x = spawnpointRect->x;
+    playerRect->y = spawnpointRect->y;
     playerVel->vy = 0;  // Reset vertical velocity
     playerVel->vx = 0;  // Reset horizontal velocity
+    propertyManager.markChanged<RectProperty>(objectID);
+    respawnPending = false;
 
     // Reset scroll counts if needed
     rightScrollCount = 0;
     leftScrollCount = 0;
 }
 
-SpawnEventData Game::sendSpawnEvent(int objectID, int spawnX, int spawnY) {
-	zmq::message_t request(sizeof(clientId) + sizeof(SpawnEventData)); // Request message with client ID and spawn data
-
-	SpawnEventData spawnData; // Data structure to hold spawn position
-
-	spawnData.spawnX = spawnX;
-	spawnData.spawnY = spawnY;
-
-    // Copy the client ID and spawnData into the request
-    memcpy(request.data(), &clientId, sizeof(clientId));
-    memcpy(static_cast<char*>(request.data()) + sizeof(clientId), &spawnData, sizeof(SpawnEventData));
-
-    // Send the request to the server
-    eventReqSocket.send(request, zmq::send_flags::none);
-
-    // Receive acknowledgment from the server
-    zmq::message_t reply;
-    eventReqSocket.recv(reply);
-
-	// Extract the spawn data from the reply
-    memcpy(&spawnData, static_cast<char*>(reply.data()) + sizeof(clientId), sizeof(spawnData));
-
-    return spawnData;
-}
-
 void Game::handleInput(int objectID, const InputAction& inputAction) {
-    auto& propertyManager = PropertyManager::getInstance();
-    auto playerVel = std::static_pointer_cast<VelocityProperty>(propertyManager.getProperty(objectID, "Velocity"));
-	auto playerInput = std::static_pointer_cast<InputProperty>(propertyManager.getProperty(objectID, "Input"));
+    auto& propertyManager = world.getPropertyManager();
+    auto playerVel = propertyManager.getProperty<VelocityProperty>(objectID);
+	auto playerInput = propertyManager.getProperty<InputProperty>(objectID);
 
     if (inputAction == MOVE_LEFT) {
         playerVel->vx = -5;
@@ -239,14 +272,16 @@ void Game::handleInput(int objectID, const InputAction& inputAction) {
 }
 
 void Game::resolveCollision(int obj1ID, int obj2ID) {
-    auto& propertyManager = PropertyManager::getInstance();
+    auto& propertyManager = world.getPropertyManager();
 
-    auto playerRect = std::static_pointer_cast<RectProperty>(propertyManager.getProperty(obj1ID, "Rect"));
-    auto playerVel = std::static_pointer_cast<VelocityProperty>(propertyManager.getProperty(obj1ID, "Velocity"));
-    auto playerPhysics = std::static_pointer_cast<PhysicsProperty>(propertyManager.getProperty(obj1ID, "Physics"));
-	auto playerInput = std::static_pointer_cast<InputProperty>(propertyManager.getProperty(obj1ID, "Input"));
+    auto playerRect = propertyManager.getProperty<RectProperty>(obj1ID);
+    auto playerVel = propertyManager.getProperty<VelocityProperty>(obj1ID);
+    auto playerPhysics = propertyManager.getProperty<PhysicsProperty>(obj1ID);
+	auto playerInput = propertyManager.getProperty<InputProperty>(obj1ID);
 
-    auto platformRect = std::static_pointer_cast<RectProperty>(propertyManager.getProperty(obj2ID, "Rect"));
+    auto platformRect = propertyManager.getProperty<RectProperty>(obj2ID);
+    int oldX = playerRect->x;
+    int oldY = playerRect->y;
 
     // Implement collision resolution logic
     if (playerRect->y + playerRect->h / 2 < platformRect->y) { // Player is above the platform
@@ -264,14 +299,19 @@ void Game::resolveCollision(int obj1ID, int obj2ID) {
     else if (playerRect->x + playerRect->w / 2 > platformRect->x + platformRect->w) { // Player is to the right of the platform
         playerRect->x = platformRect->x + platformRect->w;  // Position the player to the right
     }
+
+    // A contact that needed no correction is not a change worth replicating
+    if (playerRect->x != oldX || playerRect->y != oldY) {
+        propertyManager.markChanged<RectProperty>(obj1ID);
+    }
 }
 
 
 
 // Update the camera to follow the player's movement
 void Game::updateCamera() {
-    auto& propertyManager = PropertyManager::getInstance();
-    std::shared_ptr<RectProperty> playerRect = std::static_pointer_cast<RectProperty>(propertyManager.getProperty(playerID, "Rect"));
+    auto& propertyManager = world.getPropertyManager();
+    RectProperty* playerRect = propertyManager.getProperty<RectProperty>(playerID);
 
     // Center the camera on the player
     cameraX = playerRect->x - (SCREEN_WIDTH / 2 - playerRect->w / 2);
@@ -284,15 +324,29 @@ void Game::updateCamera() {
 
 // Send the player's movement data to the server
 void Game::sendMovementUpdate() {
+    auto& propertyManager = world.getPropertyManager();
+
+    // Skip the round trip if the player has not moved since the last update, but keep sending
+    // periodically so the server does not time the client out. A player resting on a platform sinks
+    // in by a pixel and is pushed back out, so a changed position is compared with the one last sent.
+    auto now = std::chrono::steady_clock::now();
+    RectProperty* playerRect = propertyManager.getProperty<RectProperty>(playerID);
+    bool moved = propertyManager.hasChangedSince<RectProperty>(playerID, lastSentVersion)
+        && (playerRect->x != lastSentPosition.x || playerRect->y != lastSentPosition.y);
+    bool heartbeatDue = std::chrono::duration_cast<std::chrono::milliseconds>(now - lastSentTime).count() >= HEARTBEAT_INTERVAL_MS;
+    if (clientId != -1 && !moved && !heartbeatDue) {
+        return;
+    }
+    lastSentVersion = propertyManager.captureVersion();
+    lastSentTime = now;
+
     zmq::message_t request(sizeof(clientId) + sizeof(PlayerPosition));
 
     // Package the player ID and position
     PlayerPosition pos;
-    auto& propertyManager = PropertyManager::getInstance();
-    std::shared_ptr<RectProperty> playerRect = std::static_pointer_cast<RectProperty>(propertyManager.getProperty(playerID, "Rect"));
-
     pos.x = playerRect->x;
     pos.y = playerRect->y;
+    lastSentPosition = pos;
 
     // Copy the client ID and position into the request
     memcpy(request.data(), &clientId, sizeof(clientId));
@@ -309,6 +363,7 @@ void Game::sendMovementUpdate() {
     if (clientId == -1) {
         memcpy(&clientId, reply.data(), sizeof(clientId));
         std::cout << "Received assigned playerId: " << clientId << std::endl;
+        eventBus.setClientId(clientId);
     }
 }
 
@@ -338,31 +393,28 @@ void Game::receivePlayerPositions() {
 
 // Handle player collisions with platforms
 void Game::handleCollision(int platformID) {
-    auto& propertyManager = PropertyManager::getInstance();
-    auto playerRect = std::static_pointer_cast<RectProperty>(propertyManager.getProperty(playerID, "Rect"));
+    auto& propertyManager = world.getPropertyManager();
+    auto playerRect = propertyManager.getProperty<RectProperty>(playerID);
     SDL_Rect playRect = { playerRect->x, playerRect->y, playerRect->w, playerRect->h };
 
-    auto platformRect = std::static_pointer_cast<RectProperty>(propertyManager.getProperty(platformID, "Rect"));
+    auto platformRect = propertyManager.getProperty<RectProperty>(platformID);
     SDL_Rect platRect = { platformRect->x, platformRect->y, platformRect->w, platformRect->h };
 
     // Check for intersection between player and platform
     if (SDL_HasIntersection(&playRect, &platRect)) {
-        EventManager::getInstance().raiseEvent(std::make_shared<CollisionEvent>(playerID, platformID, &gameTimeline));
+        world.getEventManager().raiseEvent(CollisionEvent(playerID, platformID, &gameTimeline));
     }
 }
 
 
 // Check for collisions between the player and platforms/boundaries
 void Game::checkCollisions() {
-    auto& propertyManager = PropertyManager::getInstance();
-    const auto& allProperties = propertyManager.getAllProperties();
-
-    // Loop through all objects and check if they have a "Collision" property
-    for (const auto& objectPair : allProperties) {
-        int objectID = objectPair.first;
+    auto& propertyManager = world.getPropertyManager();
 
-        // Check if the object has a "Collision" property and is not the player
-        if (objectPair.second.count("Collision") && objectID != playerID) {
+    // Walk every object with both a Collision property and a position
+    for (int objectID : propertyManager.view<CollisionProperty, RectProperty>()) {
+        // Skip the player itself
+        if (objectID != playerID) {
             // Handle special cases for death zone and boundaries
             if (objectID == deathZoneID) {
                 handleDeathzone();
@@ -376,31 +428,31 @@ void Game::checkCollisions() {
 
 // Handle when the player enters the death zone
 void Game::handleDeathzone() {
-    auto& propertyManager = PropertyManager::getInstance();
-    auto playerRect = std::static_pointer_cast<RectProperty>(propertyManager.getProperty(playerID, "Rect"));
+    auto& propertyManager = world.getPropertyManager();
+    auto playerRect = propertyManager.getProperty<RectProperty>(playerID);
     SDL_Rect playRect = { playerRect->x, playerRect->y, playerRect->w, playerRect->h };
 
-    auto deathzoneRect = std::static_pointer_cast<RectProperty>(propertyManager.getProperty(deathZoneID, "Rect"));
+    auto deathzoneRect = propertyManager.getProperty<RectProperty>(deathZoneID);
     SDL_Rect deathRect = { deathzoneRect->x, deathzoneRect->y, deathzoneRect->w, deathzoneRect->h };
 
-    // If the player collides with the death zone, raise a DeathEvent
-    if (SDL_HasIntersection(&playRect, &deathRect)) {
-        EventManager::getInstance().raiseEvent(std::make_shared<DeathEvent>(playerID, &gameTimeline));
+    // If the player collides with the death zone, raise a DeathEvent (once per respawn)
+    if (!respawnPending && SDL_HasIntersection(&playRect, &deathRect)) {
+        world.getEventManager().raiseEvent(DeathEvent(playerID, &gameTimeline));
     }
 }
 
 
 // Handle player collisions with screen boundaries (left/right)
 void Game::handleBoundaries() {
-    auto& propertyManager = PropertyManager::getInstance();
-    std::shared_ptr<RectProperty> playerRect = std::static_pointer_cast<RectProperty>(propertyManager.getProperty(playerID, "Rect"));
-    std::shared_ptr<RectProperty> rightBoundaryRect = std::static_pointer_cast<RectProperty>(propertyManager.getProperty(rightBoundaryID, "Rect"));
-    std::shared_ptr<RectProperty> leftBoundaryRect = std::static_pointer_cast<RectProperty>(propertyManager.getProperty(leftBoundaryID, "Rect"));
-    std::shared_ptr<RectProperty> platformRect = std::static_pointer_cast<RectProperty>(propertyManager.getProperty(platformID, "Rect"));
-    std::shared_ptr<RectProperty> platformRect2 = std::static_pointer_cast<RectProperty>(propertyManager.getProperty(platformID2, "Rect"));
-    std::shared_ptr<RectProperty> platformRect3 = std::static_pointer_cast<RectProperty>(propertyManager.getProperty(platformID3, "Rect"));
-    std::shared_ptr<RectProperty> movingPlatformRect = std::static_pointer_cast<RectProperty>(propertyManager.getProperty(movingPlatformID, "Rect"));
-    std::shared_ptr<RectProperty> movingPlatformRect2 = std::static_pointer_cast<RectProperty>(propertyManager.getProperty(movingPlatformID2, "Rect"));
+    auto& propertyManager = world.getPropertyManager();
+    RectProperty* playerRect = propertyManager.getProperty<RectProperty>(playerID);
+    RectProperty* rightBoundaryRect = propertyManager.getProperty<RectProperty>(rightBoundaryID);
+    RectProperty* leftBoundaryRect = propertyManager.getProperty<RectProperty>(leftBoundaryID);
+    RectProperty* platformRect = propertyManager.getProperty<RectProperty>(platformID);
+    RectProperty* platformRect2 = propertyManager.getProperty<RectProperty>(platformID2);
+    RectProperty* platformRect3 = propertyManager.getProperty<RectProperty>(platformID3);
+    RectProperty* movingPlatformRect = propertyManager.getProperty<RectProperty>(movingPlatformID);
+    RectProperty* movingPlatformRect2 = propertyManager.getProperty<RectProperty>(movingPlatformID2);
 
     SDL_Rect playRect = { playerRect->x, playerRect->y, playerRect->w, playerRect->h };
     SDL_Rect rightRect = { rightBoundaryRect->x, rightBoundaryRect->y, rightBoundaryRect->w, rightBoundaryRect->h };
@@ -421,7 +473,7 @@ void Game::handleBoundaries() {
 
 // Update the game state, including player movement, platform movement, and collision checks
 void Game::update() {
-    auto& propertyManager = PropertyManager::getInstance();
+    auto& propertyManager = world.getPropertyManager();
 
     // Update game objects (e.g., player position, platform movement)
     updateGameObjects();
@@ -432,13 +484,15 @@ void Game::update() {
 
 // Update game object properties
 void Game::updateGameObjects() {
-    auto& propertyManager = PropertyManager::getInstance();
+    auto& propertyManager = world.getPropertyManager();
 
     // Update player position based on velocity
-    std::shared_ptr<RectProperty> playerRect = std::static_pointer_cast<RectProperty>(propertyManager.getProperty(playerID, "Rect"));
-    std::shared_ptr<VelocityProperty> playerVel = std::static_pointer_cast<VelocityProperty>(propertyManager.getProperty(playerID, "Velocity"));
+    RectProperty* playerRect = propertyManager.getProperty<RectProperty>(playerID);
+    VelocityProperty* playerVel = propertyManager.getProperty<VelocityProperty>(playerID);
 
     // Update the player's position using its velocity
+    int oldX = playerRect->x;
+    int oldY = playerRect->y;
     playerRect->x += playerVel->vx;
     playerRect->y += playerVel->vy;
 
@@ -453,13 +507,19 @@ void Game::updateGameObjects() {
         playerRect->y = SCREEN_HEIGHT;  // Clamp the player to the ground
         playerVel->vy = 0;  // Stop falling
     }
+    if (playerRect->x != oldX || playerRect->y != oldY) {
+        propertyManager.markChanged<RectProperty>(playerID);
+    }
 
     // 3. Update moving platform position (horizontal)
-    std::shared_ptr<RectProperty> movingPlatformRect = std::static_pointer_cast<RectProperty>(propertyManager.getProperty(movingPlatformID, "Rect"));
-    std::shared_ptr<VelocityProperty> movingPlatformVel = std::static_pointer_cast<VelocityProperty>(propertyManager.getProperty(movingPlatformID, "Velocity"));
+    RectProperty* movingPlatformRect = propertyManager.getProperty<RectProperty>(movingPlatformID);
+    VelocityProperty* movingPlatformVel = propertyManager.getProperty<VelocityProperty>(movingPlatformID);
 
     if (movingPlatformVel) {
         movingPlatformRect->x += movingPlatformVel->vx;  // Update the position based on velocity
+        if (movingPlatformVel->vx != 0) {
+            propertyManager.markChanged<RectProperty>(movingPlatformID);
+        }
     }
     else {
         std::cerr << "Error: movingPlatformVel is null" << std::endl;
@@ -471,10 +531,13 @@ void Game::updateGameObjects() {
     }
 
     // Update second moving platform (vertical movement)
-    std::shared_ptr<RectProperty> movingPlatformRect2 = std::static_pointer_cast<RectProperty>(propertyManager.getProperty(movingPlatformID2, "Rect"));
-    std::shared_ptr<VelocityProperty> movingPlatformVel2 = std::static_pointer_cast<VelocityProperty>(propertyManager.getProperty(movingPlatformID2, "Velocity"));
+    RectProperty* movingPlatformRect2 = propertyManager.getProperty<RectProperty>(movingPlatformID2);
+    VelocityProperty* movingPlatformVel2 = propertyManager.getProperty<VelocityProperty>(movingPlatformID2);
 
     movingPlatformRect2->y += movingPlatformVel2->vy;  // Update the position based on velocity
+    if (movingPlatformVel2->vy != 0) {
+        propertyManager.markChanged<RectProperty>(movingPlatformID2);
+    }
     if (movingPlatformRect2->y <= 0 || movingPlatformRect2->y >= SCREEN_HEIGHT - movingPlatformRect2->h) {  // Reverse direction
         movingPlatformVel2->vy = -movingPlatformVel2->vy;
     }
@@ -486,21 +549,21 @@ void Game::render() {
     SDL_SetRenderDrawColor(renderer, 0, 0, 255, 255);  // Blue background
     SDL_RenderClear(renderer);
 
-    // Render static platforms and moving platforms
-    renderPlatform(platformID);  // Render the first platform
-    renderPlatform(platformID2);  // Render the second platform
-    renderPlatform(platformID3);  // Render the third platform
-
-    renderPlatform(movingPlatformID);  // Render the first moving platform
-    renderPlatform(movingPlatformID2);  // Render the second moving platform
+    // Render every visible object (static and moving platforms) except the player
+    auto& propertyManager = world.getPropertyManager();
+    for (int objectID : propertyManager.view<RectProperty, RenderProperty>()) {
+        if (objectID != playerID) {
+            renderPlatform(objectID);
+        }
+    }
 
-    // Render player character
+    // Render player character on top
     renderPlayer(playerID);
 
     // Render other players, adjusted by the camera offset
     for (const auto& player : allPlayers) {
         int id = player.first;
-        if (id != clientId) {
+        if (id != clientId && deadPlayers.count(id) == 0) {
             PlayerPosition pos = player.second;
 
             // Adjust the player position based on the camera position
@@ -516,26 +579,26 @@ void Game::render() {
 
 // Helper function to render platforms
 void Game::renderPlatform(int platformID) {
-    auto& propertyManager = PropertyManager::getInstance();
-    std::shared_ptr<RectProperty> rect = std::static_pointer_cast<RectProperty>(propertyManager.getProperty(platformID, "Rect"));
+    auto& propertyManager = world.getPropertyManager();
+    RectProperty* rect = propertyManager.getProperty<RectProperty>(platformID);
 
     // Adjust the platform position based on the camera offset
     SDL_Rect platformRect = { rect->x - cameraX, rect->y - cameraY, rect->w, rect->h };
 
-    std::shared_ptr<RenderProperty> render = std::static_pointer_cast<RenderProperty>(propertyManager.getProperty(platformID, "Render"));
+    RenderProperty* render = propertyManager.getProperty<RenderProperty>(platformID);
     SDL_SetRenderDrawColor(renderer, render->r, render->g, render->b, 255);
     SDL_RenderFillRect(renderer, &platformRect);
 }
 
 // Helper function to render player
 void Game::renderPlayer(int playerID) {
-    auto& propertyManager = PropertyManager::getInstance();
-    std::shared_ptr<RectProperty> rect = std::static_pointer_cast<RectProperty>(propertyManager.getProperty(playerID, "Rect"));
+    auto& propertyManager = world.getPropertyManager();
+    RectProperty* rect = propertyManager.getProperty<RectProperty>(playerID);
 
     // Adjust player position based on camera offset
     SDL_Rect playerRect = { rect->x - cameraX, rect->y - cameraY, rect->w, rect->h };
 
-    std::shared_ptr<RenderProperty> render = std::static_pointer_cast<RenderProperty>(propertyManager.getProperty(playerID, "Render"));
+    RenderProperty* render = propertyManager.getProperty<RenderProperty>(playerID);
     SDL_SetRenderDrawColor(renderer, render->r, render->g, render->b, 255);
     SDL_RenderFillRect(renderer, &playerRect);
 }
\ No newline at end of file
@@ -3,13 +3,16 @@
 #include <SDL2/SDL.h>
 #include <zmq.hpp>
 #include <unordered_map>
+#include <unordered_set>
 #include <chrono>
 #include <mutex>
 #include <memory>
 #include "Timeline.h"       // For timeline functionality (pausing/unpausing, time scaling)
+#include "World.h"
 #include "PropertyManager.h" // For property-based game objects
 #include "ThreadManager.h"   // For multithreading platform updates
 #include "EventManager.h"    // Event management system
+#include "NetworkEventBus.h"  // Shares deaths and spawns with the other clients
 #include "DeathEvent.h"      // Specific event types
 #include "SpawnEvent.h"
 #include "InputEvent.h"
@@ -23,6 +26,18 @@ struct PlayerPosition {
 #define SCREEN_WIDTH 1920
 #define SCREEN_HEIGHT 1080
 
+// Maximum time between position updates sent to the server while the player is standing still
+#define HEARTBEAT_INTERVAL_MS 1000
+
+// Game time between the player dying and respawning
+#define RESPAWN_DELAY_MS 500
+
+// Snapshot of the level's objects, written on first run and loaded on every later start
+#define PLATFORMER_WORLD_FILE "platformer.world"
+
+// Version of createLevelObjects(); bump it whenever the level changes so old snapshots are rebuilt
+#define PLATFORMER_LAYOUT_VERSION 1
+
 // Forward declarations for properties used in the game (RectProperty, VelocityProperty)
 class RectProperty;
 class VelocityProperty;
@@ -34,12 +49,13 @@ class Game {
 public:
     /**
      * @brief Constructs a Game object with an SDL renderer and ZeroMQ sockets.
+     * @param world The world holding this game's objects and events.
      * @param renderer SDL renderer for drawing the game.
      * @param reqSocket ZeroMQ request socket for sending player position data to the server.
      * @param subSocket ZeroMQ subscriber socket for receiving updates from the server.
-     * @param eventReqSocket ZeroMQ socket for sending event data to the server.
+     * @param eventBus Bus that sends this world's replicated events to the other clients and raises theirs.
      */
-    Game(SDL_Renderer* renderer, zmq::socket_t& reqSocket, zmq::socket_t& subSocket, zmq::socket_t& eventReqSocket);
+    Game(World& world, SDL_Renderer* renderer, zmq::socket_t& reqSocket, zmq::socket_t& subSocket, NetworkEventBus& eventBus);
 
     /**
      * @brief Destructor to clean up resources when the game is destroyed.
@@ -51,6 +67,17 @@ public:
      */
     void run();
 
+    /**
+     * @brief Plays back a recorded session as fast as it runs, instead of running the game loop.
+     *
+     * Each frame dispatches the events the recorded frame dispatched, then updates the game as run()
+     * does. Nothing is rendered, and local input and the network are not used; their effects are
+     * in the journal.
+     *
+     * @param reader An open journal recorded with --record-events.
+     */
+    void replay(EventJournalReader& reader);
+
 private:
     // Initialization and setup
     /**
@@ -58,6 +85,11 @@ private:
      */
     void initGameObjects();
 
+    /**
+     * @brief Creates the level's objects from code; used when no world snapshot exists yet.
+     */
+    void createLevelObjects();
+
     // Game object update functions
     /**
      * @brief Updates the overall game state, including player movement and collision checks.
@@ -157,14 +189,15 @@ private:
      */
     void receivePlayerPositions();
 
-    /**
-     * @brief Sends a spawn event to the server.
-     * @param objectID ID of the object to spawn.
-     * @param spawnX X-coordinate for spawning.
-     * @param spawnY Y-coordinate for spawning.
-     * @return SpawnEventData containing the spawn location.
-     */
-    SpawnEventData sendSpawnEvent(int objectID, int spawnX, int spawnY);
+    World& world;            // World holding this game's objects and events
+
+    // Event handler registrations; destroying the game unregisters its handlers
+    Subscription inputSubscription;     // INPUT handler
+    Subscription collisionSubscription; // COLLISION handler
+    Subscription deathSubscription;     // DEATH handler
+    Subscription spawnSubscription;     // SPAWN handler
+    Subscription remoteDeathSubscription; // DEATH handler for other clients' players
+    Subscription remoteSpawnSubscription; // SPAWN handler for other clients' players
 
     // SDL-related variables
     SDL_Renderer* renderer;  // SDL renderer responsible for drawing game objects to the screen
@@ -173,7 +206,7 @@ private:
     // Networking-related variables
     zmq::socket_t& reqSocket;      // ZeroMQ request socket for player position data
     zmq::socket_t& subSocket;      // ZeroMQ subscriber socket for updates
-    zmq::socket_t& eventReqSocket; // ZeroMQ request socket for event data
+    NetworkEventBus& eventBus;     // Replicates deaths and spawns to and from the other clients
 
     // Game object and property IDs
     int clientId;                // Unique ID assigned to the player's character
@@ -187,6 +220,14 @@ private:
     // Player positions and rendering
     std::unordered_map<int, PlayerPosition> allPlayers; // Map storing positions of all players
     std::unordered_map<int, SDL_Rect> allRects;         // Map for rendering each player
+    std::unordered_set<int> deadPlayers;                // Clients whose player died and has not respawned yet
+
+    // Change tracking for position replication
+    uint32_t lastSentVersion;                          // Property version captured when the position was last sent
+    PlayerPosition lastSentPosition;                   // Position last sent to the server
+    std::chrono::steady_clock::time_point lastSentTime; // Time the position was last sent to the server
+
+    bool respawnPending;         // Whether the player has died and a respawn is scheduled
 
     // Timeline and time management
     Timeline gameTimeline; // Manages pausing, unpausing, and time scaling
@@ -1,5 +1,6 @@
 #include "game2.h"
 #include "PropertyManager.h"
+#include "WorldSnapshot.h"
 #include "ThreadManager.h"
 #include <iostream>
 #include <cstring>
@@ -10,8 +11,8 @@
 #include "CollisionEvent.h"
 
 // Constructor
-Game2::Game2(SDL_Renderer* renderer, zmq::socket_t& reqSocket, zmq::socket_t& subSocket, zmq::socket_t& eventReqSocket)
-    : renderer(renderer), reqSocket(reqSocket), subSocket(subSocket), eventReqSocket(eventReqSocket), quit(false),
+Game2::Game2(World& world, SDL_Renderer* renderer, zmq::socket_t& reqSocket, zmq::socket_t& subSocket, zmq::socket_t& eventReqSocket)
+    : world(world), renderer(renderer), reqSocket(reqSocket), subSocket(subSocket), eventReqSocket(eventReqSocket), quit(false),
     gameTimeline(nullptr, 1.0f), font(nullptr), levelTexture(nullptr), clientId(-1) {
     // Initialize SDL_ttf for text rendering
     if (TTF_Init() == -1) {
@@ -28,6 +29,27 @@ Game2::Game2(SDL_Renderer* renderer, zmq::socket_t& reqSocket, zmq::socket_t& su
         return;
     }
 
+    // Reserve object and property storage once so waves and projectiles reuse the same memory
+    auto& propertyManager = world.getPropertyManager();
+    propertyManager.reserveObjects(MAX_GAME_OBJECTS);
+    propertyManager.reserveProperties<RectProperty>(MAX_GAME_OBJECTS);
+    propertyManager.reserveProperties<RenderProperty>(MAX_GAME_OBJECTS);
+    propertyManager.reserveProperties<VelocityProperty>(MAX_GAME_OBJECTS);
+    projectileSlots.assign(MAX_GAME_OBJECTS, Entity::INVALID_ID);
+
+    // Define the bundles aliens and projectiles are instantiated from; positions are set per instance
+    alienPrefab.set(RectProperty(0, 0, ALIEN_WIDTH, ALIEN_HEIGHT))
+        .set(RenderProperty(255, 0, 0)); // Red aliens
+    projectilePrefab.set(RectProperty(0, 0, PROJECTILE_WIDTH, PROJECTILE_HEIGHT))
+        .set(RenderProperty(255, 255, 255)) // White projectile
+        .set(VelocityProperty(0, -10));     // Moves upward
+    alienProjectilePrefab.set(RectProperty(0, 0, PROJECTILE_WIDTH, PROJECTILE_HEIGHT))
+        .set(RenderProperty(255, 255, 0)) // Yellow projectile
+        .set(VelocityProperty(0, 5));     // Moves downward
+
+    // Keep event storms from stalling a frame; whatever does not fit is dispatched next frame
+    world.getEventManager().setDispatchBudget(0, EVENT_DISPATCH_BUDGET_US);
+
     // Initialize game objects like the player and aliens
     initGameObjects();
 }
@@ -46,26 +68,73 @@ Game2::~Game2() {
 
 // Initialize game objects
 void Game2::initGameObjects() {
-    auto& propertyManager = PropertyManager::getInstance();
-    auto& eventManager = EventManager::getInstance();
+    auto& propertyManager = world.getPropertyManager();
+    auto& eventManager = world.getEventManager();
+
+    // Load the player and alien grid from the level snapshot; build them (and write the snapshot) on first run
+    std::vector<int> namedIDs;
+    if (WorldSnapshot::load(propertyManager, INVADERS_WORLD_FILE, namedIDs, INVADERS_LAYOUT_VERSION) && !namedIDs.empty()) {
+        playerID = namedIDs[0];
+        alienIDs.assign(namedIDs.begin() + 1, namedIDs.end());
+    }
+    else {
+        createLevelObjects();
+        namedIDs.clear();
+        namedIDs.push_back(playerID);
+        namedIDs.insert(namedIDs.end(), alienIDs.begin(), alienIDs.end());
+        WorldSnapshot::save(propertyManager, INVADERS_WORLD_FILE, namedIDs, INVADERS_LAYOUT_VERSION);
+    }
+
+    // Register SPAWN and DEATH handlers for the player and each alien, so every event goes
+    // straight to the handler for the object it is about
+    spawnSubscription = eventManager.subscribe(SPAWN, playerID, [this](const Event&) {
+        handleSpawn();
+        });
+
+    deathSubscription = eventManager.subscribe(DEATH, playerID, [this](const Event&) {
+        handleDeath();
+        });
 
-    // Register event handlers for SPAWN and DEATH events
-    eventManager.registerHandler(SPAWN, [this](std::shared_ptr<Event> event) {
-        auto spawnEvent = std::static_pointer_cast<SpawnEvent>(event);
-        handleSpawn(spawnEvent->getObjectID());
+    // Projectiles come and go every few frames, so they share one DEATH handler instead of
+    // registering (and allocating) a handler each
+    projectileDeathSubscription = eventManager.subscribe(DEATH, [this](const Event& event) {
+        handleProjectileDeath(DeathEvent(event).getObjectID());
         });
 
-    eventManager.registerHandler(DEATH, [this](std::shared_ptr<Event> event) {
-        auto deathEvent = std::static_pointer_cast<DeathEvent>(event);
-        handleDeath(deathEvent->getObjectID());
+    for (int alienID : alienIDs) {
+        objectDeathSubscriptions[alienID] = eventManager.subscribe(DEATH, alienID, [this, alienID](const Event&) {
+            handleAlienDeath(alienID);
+            });
+    }
+
+    // Drive the aliens from timers that reschedule themselves, so their pace follows game time
+    int alienMoveTimerID = nextTimerID++;
+    int alienShootTimerID = nextTimerID++;
+
+    alienMoveSubscription = eventManager.subscribe(TIMER, alienMoveTimerID, [this, alienMoveTimerID](const Event&) {
+        moveAliens();
+        world.getEventManager().scheduleEvent(TimerEvent(alienMoveTimerID, &gameTimeline), levelDelay(ALIEN_MOVE_INTERVAL_MS));
+        });
+
+    alienShootSubscription = eventManager.subscribe(TIMER, alienShootTimerID, [this, alienShootTimerID](const Event&) {
+        fireAlienProjectile();
+        world.getEventManager().scheduleEvent(TimerEvent(alienShootTimerID, &gameTimeline), levelDelay(ALIEN_SHOOT_INTERVAL_MS));
         });
 
+    eventManager.scheduleEvent(TimerEvent(alienMoveTimerID, &gameTimeline), levelDelay(ALIEN_MOVE_INTERVAL_MS));
+    eventManager.scheduleEvent(TimerEvent(alienShootTimerID, &gameTimeline), levelDelay(ALIEN_SHOOT_INTERVAL_MS));
+}
+
+// Create the player and alien grid from code
+void Game2::createLevelObjects() {
+    auto& propertyManager = world.getPropertyManager();
+
     // Create the player object and initialize its properties
     playerID = propertyManager.createObject();
-    propertyManager.addProperty(playerID, "Rect", std::make_shared<RectProperty>(
+    propertyManager.addProperty(playerID, RectProperty(
         SCREEN_WIDTH / 2 - PLAYER_WIDTH / 2, SCREEN_HEIGHT - 60, PLAYER_WIDTH, PLAYER_HEIGHT));
-    propertyManager.addProperty(playerID, "Render", std::make_shared<RenderProperty>(0, 255, 0)); // Green player
-    propertyManager.addProperty(playerID, "Velocity", std::make_shared<VelocityProperty>(0, 0));
+    propertyManager.addProperty(playerID, RenderProperty(0, 255, 0)); // Green player
+    propertyManager.addProperty(playerID, VelocityProperty(0, 0));
 
     // Create aliens in a grid layout
     int numColumns = 10;
@@ -74,13 +143,14 @@ void Game2::initGameObjects() {
     int startX = (SCREEN_WIDTH - totalAlienWidth) / 2;
     int startY = 50;
 
+    // Create the whole grid from the alien prefab in one batch, then move each alien into place
+    size_t firstAlien = alienIDs.size();
+    propertyManager.instantiate(alienPrefab, numRows * numColumns, alienIDs);
     for (int i = 0; i < numRows; ++i) {
         for (int j = 0; j < numColumns; ++j) {
-            int alienID = propertyManager.createObject();
-            propertyManager.addProperty(alienID, "Rect", std::make_shared<RectProperty>(
-                startX + j * (ALIEN_WIDTH + 10), startY + i * (ALIEN_HEIGHT + 10), ALIEN_WIDTH, ALIEN_HEIGHT));
-            propertyManager.addProperty(alienID, "Render", std::make_shared<RenderProperty>(255, 0, 0)); // Red aliens
-            alienIDs.push_back(alienID);
+            auto alienRect = propertyManager.getProperty<RectProperty>(alienIDs[firstAlien + i * numColumns + j]);
+            alienRect->x = startX + j * (ALIEN_WIDTH + 10);
+            alienRect->y = startY + i * (ALIEN_HEIGHT + 10);
         }
     }
 }
@@ -97,7 +167,7 @@ void Game2::run() {
 
             // Process game events and updates
             handleEvents();
-			EventManager::getInstance().dispatchEvents();
+			world.getEventManager().dispatchEvents(gameTimeline.getTime());
             receiveServerUpdates(); // Integrate server updates
             update();
             render();
@@ -113,8 +183,6 @@ void Game2::run() {
 
 // Handle events
 void Game2::handleEvents() {
-    static bool isSpacePressed = false;
-
     // Poll SDL events, such as quit or keyboard input
     while (SDL_PollEvent(&e) != 0) {
         if (e.type == SDL_QUIT) {
@@ -123,8 +191,8 @@ void Game2::handleEvents() {
     }
 
     const Uint8* keystates = SDL_GetKeyboardState(nullptr);
-    auto& propertyManager = PropertyManager::getInstance();
-    auto playerVel = std::static_pointer_cast<VelocityProperty>(propertyManager.getProperty(playerID, "Velocity"));
+    auto& propertyManager = world.getPropertyManager();
+    auto playerVel = propertyManager.getProperty<VelocityProperty>(playerID);
 
     // Handle player movement using arrow keys
     if (keystates[SDL_SCANCODE_LEFT]) {
@@ -154,8 +222,8 @@ void Game2::sendPlayerUpdate() {
     zmq::message_t request(sizeof(clientId) + sizeof(PlayerPosition));
 
     PlayerPosition pos;
-    auto& propertyManager = PropertyManager::getInstance();
-    auto playerRect = std::static_pointer_cast<RectProperty>(propertyManager.getProperty(playerID, "Rect"));
+    auto& propertyManager = world.getPropertyManager();
+    auto playerRect = propertyManager.getProperty<RectProperty>(playerID);
 
     // Populate player position data
     pos.x = playerRect->x;
@@ -201,63 +269,60 @@ void Game2::receiveServerUpdates() {
 
 // Fire a projectile
 void Game2::fireProjectile() {
-    auto& propertyManager = PropertyManager::getInstance();
-    auto playerRect = std::static_pointer_cast<RectProperty>(propertyManager.getProperty(playerID, "Rect"));
-
-    int projectileID = propertyManager.createObject();
-    propertyManager.addProperty(projectileID, "Rect", std::make_shared<RectProperty>(
-        playerRect->x + PLAYER_WIDTH / 2 - PROJECTILE_WIDTH / 2,
-        playerRect->y,
-        PROJECTILE_WIDTH,
-        PROJECTILE_HEIGHT));
-    propertyManager.addProperty(projectileID, "Render", std::make_shared<RenderProperty>(255, 255, 255)); // White projectile
-    propertyManager.addProperty(projectileID, "Velocity", std::make_shared<VelocityProperty>(0, -10)); // Moves upward
+    auto& propertyManager = world.getPropertyManager();
+    auto playerRect = propertyManager.getProperty<RectProperty>(playerID);
+    int spawnX = playerRect->x + PLAYER_WIDTH / 2 - PROJECTILE_WIDTH / 2;
+    int spawnY = playerRect->y;
+
+    // Spawning may grow the Rect storage, so the player's rectangle is not used past this point
+    int projectileID = propertyManager.instantiate(projectilePrefab);
+    auto projRect = propertyManager.getProperty<RectProperty>(projectileID);
+    projRect->x = spawnX;
+    projRect->y = spawnY;
     projectileIDs.push_back(projectileID);
 
+    // Let the DEATH handler recognise the projectile without searching projectileIDs
+    size_t slot = static_cast<size_t>(Entity::getIndex(projectileID));
+    if (slot >= projectileSlots.size()) {
+        projectileSlots.resize(slot + 1, Entity::INVALID_ID);
+    }
+    projectileSlots[slot] = projectileID;
+
     // Raise a SpawnEvent for the projectile
-    EventManager::getInstance().raiseEvent(std::make_shared<SpawnEvent>(projectileID, &gameTimeline));
+    world.getEventManager().raiseEvent(SpawnEvent(projectileID, &gameTimeline));
 }
 
 
 // Update game state
 void Game2::update() {
-    auto& propertyManager = PropertyManager::getInstance();
-
-    // Store IDs of objects to be removed after collision detection
-    std::vector<int> aliensToRemove;
-    std::vector<int> projectilesToRemove;
+    auto& propertyManager = world.getPropertyManager();
+    auto& commands = propertyManager.getCommandBuffer();
 
     // Check for collisions between projectiles and aliens
     for (int projID : projectileIDs) {
-        auto projRect = std::static_pointer_cast<RectProperty>(propertyManager.getProperty(projID, "Rect"));
+        auto projRect = propertyManager.getProperty<RectProperty>(projID);
         SDL_Rect projSDL = { projRect->x, projRect->y, projRect->w, projRect->h };
 
         for (int alienID : alienIDs) {
-            auto alienRect = std::static_pointer_cast<RectProperty>(propertyManager.getProperty(alienID, "Rect"));
+            auto alienRect = propertyManager.getProperty<RectProperty>(alienID);
             SDL_Rect alienSDL = { alienRect->x, alienRect->y, alienRect->w, alienRect->h };
 
             if (SDL_HasIntersection(&projSDL, &alienSDL)) {
                 // Raise death events for the destroyed objects
-                EventManager::getInstance().raiseEvent(std::make_shared<DeathEvent>(alienID, &gameTimeline));
-                EventManager::getInstance().raiseEvent(std::make_shared<DeathEvent>(projID, &gameTimeline));
+                world.getEventManager().raiseEvent(DeathEvent(alienID, &gameTimeline));
+                world.getEventManager().raiseEvent(DeathEvent(projID, &gameTimeline));
 
-                // Add IDs to removal lists for both aliens and projectiles
-                aliensToRemove.push_back(alienID);
-                projectilesToRemove.push_back(projID);
+                // Defer destruction until collision detection is done
+                commands.destroyObject(alienID);
+                commands.destroyObject(projID);
             }
         }
     }
 
-    // Remove collided aliens and projectiles
-    for (int alienID : aliensToRemove) {
-        alienIDs.erase(std::remove(alienIDs.begin(), alienIDs.end(), alienID), alienIDs.end());
-        propertyManager.destroyObject(alienID);
-    }
-
-    for (int projID : projectilesToRemove) {
-        projectileIDs.erase(std::remove(projectileIDs.begin(), projectileIDs.end(), projID), projectileIDs.end());
-        propertyManager.destroyObject(projID);
-    }
+    // Remove collided aliens and projectiles in one batch
+    propertyManager.applyCommands();
+    removeDestroyedIDs(alienIDs);
+    removeDestroyedIDs(projectileIDs);
 
     // Update all remaining game objects
     updateGameObjects();
@@ -266,11 +331,12 @@ void Game2::update() {
 
 // Update game objects
 void Game2::updateGameObjects() {
-    auto& propertyManager = PropertyManager::getInstance();
+    auto& propertyManager = world.getPropertyManager();
+    auto& commands = propertyManager.getCommandBuffer();
 
     // Update the player's position based on velocity
-    auto playerRect = std::static_pointer_cast<RectProperty>(propertyManager.getProperty(playerID, "Rect"));
-    auto playerVel = std::static_pointer_cast<VelocityProperty>(propertyManager.getProperty(playerID, "Velocity"));
+    auto playerRect = propertyManager.getProperty<RectProperty>(playerID);
+    auto playerVel = propertyManager.getProperty<VelocityProperty>(playerID);
     playerRect->x += playerVel->vx;
 
     // Ensure the player remains within screen bounds
@@ -278,118 +344,56 @@ void Game2::updateGameObjects() {
     if (playerRect->x + PLAYER_WIDTH > SCREEN_WIDTH) playerRect->x = SCREEN_WIDTH - PLAYER_WIDTH;
 
     // Update positions of player projectiles
-    for (auto it = projectileIDs.begin(); it != projectileIDs.end();) {
-        auto projRect = std::static_pointer_cast<RectProperty>(propertyManager.getProperty(*it, "Rect"));
+    for (int projID : projectileIDs) {
+        auto projRect = propertyManager.getProperty<RectProperty>(projID);
         projRect->y -= 10; // Move projectile upward
 
         // Remove projectile if it goes off-screen
         if (projRect->y + PROJECTILE_HEIGHT < 0) {
-            EventManager::getInstance().raiseEvent(std::make_shared<DeathEvent>(*it, &gameTimeline));
-            propertyManager.destroyObject(*it);
-            it = projectileIDs.erase(it);
-        }
-        else {
-            ++it;
+            world.getEventManager().raiseEvent(DeathEvent(projID, &gameTimeline));
+            commands.destroyObject(projID);
         }
     }
 
-    // Handle alien movement and shooting logic
-    static int alienMoveTimer = 0;
-    static int alienDirection = 1; // 1 for moving right, -1 for moving left
-
-    ++alienMoveTimer;
-    float tic = gameTimeline.getTic(); // Get the current tic rate
-
-    if (alienMoveTimer >= static_cast<int>(30 / tic)) { // Adjust movement rate by tic
-        alienMoveTimer = 0;
-        bool changeDirection = false;
-
-        for (int alienID : alienIDs) {
-            auto alienRect = std::static_pointer_cast<RectProperty>(propertyManager.getProperty(alienID, "Rect"));
-            alienRect->x += alienDirection * 10;
-
-            // Check if aliens hit the screen edges
-            if (alienRect->x < 0 || alienRect->x + ALIEN_WIDTH > SCREEN_WIDTH) {
-                changeDirection = true;
-            }
-        }
-
-        // Reverse direction and move aliens downward if they hit the screen edge
-        if (changeDirection) {
-            alienDirection *= -1;
-            for (int alienID : alienIDs) {
-                auto alienRect = std::static_pointer_cast<RectProperty>(propertyManager.getProperty(alienID, "Rect"));
-                alienRect->y += 20;
-            }
-        }
-    }
-
-    // Handle alien shooting logic
-    static int alienShootTimer = 0;
-    ++alienShootTimer;
-
-    if (alienShootTimer >= static_cast<int>(100 / tic)) { // Adjust shooting rate by tic
-        alienShootTimer = 0;
-
-        if (!alienIDs.empty()) {
-            int randomIndex = rand() % alienIDs.size();
-            int shootingAlienID = alienIDs[randomIndex];
-            auto alienRect = std::static_pointer_cast<RectProperty>(propertyManager.getProperty(shootingAlienID, "Rect"));
-
-            // Create a projectile from the alien's position
-            int alienProjID = propertyManager.createObject();
-            propertyManager.addProperty(alienProjID, "Rect", std::make_shared<RectProperty>(
-                alienRect->x + ALIEN_WIDTH / 2 - PROJECTILE_WIDTH / 2,
-                alienRect->y + ALIEN_HEIGHT,
-                PROJECTILE_WIDTH,
-                PROJECTILE_HEIGHT));
-            propertyManager.addProperty(alienProjID, "Render", std::make_shared<RenderProperty>(255, 255, 0)); // Yellow projectile
-            propertyManager.addProperty(alienProjID, "Velocity", std::make_shared<VelocityProperty>(0, 5));   // Move downward
-            alienProjectileIDs.push_back(alienProjID);
-
-            // Raise a SpawnEvent for the new alien projectile
-            EventManager::getInstance().raiseEvent(std::make_shared<SpawnEvent>(alienProjID, &gameTimeline));
-        }
-    }
+    SDL_Rect playerSDL = { playerRect->x, playerRect->y, playerRect->w, playerRect->h };
 
     // Update alien projectiles
-    for (auto it = alienProjectileIDs.begin(); it != alienProjectileIDs.end();) {
-        auto projRect = std::static_pointer_cast<RectProperty>(propertyManager.getProperty(*it, "Rect"));
+    for (int alienProjID : alienProjectileIDs) {
+        auto projRect = propertyManager.getProperty<RectProperty>(alienProjID);
         projRect->y += 5; // Move projectile downward
 
         SDL_Rect projSDL = { projRect->x, projRect->y, projRect->w, projRect->h };
-        SDL_Rect playerSDL = { playerRect->x, playerRect->y, playerRect->w, playerRect->h };
 
         // Check for collision with the player
         if (SDL_HasIntersection(&projSDL, &playerSDL)) {
             // Raise DeathEvent for both the player and the projectile
-            EventManager::getInstance().raiseEvent(std::make_shared<DeathEvent>(playerID, &gameTimeline));
-            EventManager::getInstance().raiseEvent(std::make_shared<DeathEvent>(*it, &gameTimeline));
+            world.getEventManager().raiseEvent(DeathEvent(playerID, &gameTimeline));
+            world.getEventManager().raiseEvent(DeathEvent(alienProjID, &gameTimeline));
 
-            propertyManager.destroyObject(playerID);
-            propertyManager.destroyObject(*it);
-            it = alienProjectileIDs.erase(it);
+            commands.destroyObject(playerID);
+            commands.destroyObject(alienProjID);
 
             // End the game as the player has been hit
             std::cout << "Player has been destroyed! Resetting game..." << std::endl;
             gameOver = true;
         }
         else if (projRect->y > SCREEN_HEIGHT) { // Remove off-screen projectiles
-            EventManager::getInstance().raiseEvent(std::make_shared<DeathEvent>(*it, &gameTimeline));
-            propertyManager.destroyObject(*it);
-            it = alienProjectileIDs.erase(it);
-        }
-        else {
-            ++it;
+            world.getEventManager().raiseEvent(DeathEvent(alienProjID, &gameTimeline));
+            commands.destroyObject(alienProjID);
         }
     }
 
+    // Apply all deferred removals at once, then drop the destroyed IDs from the lists
+    propertyManager.applyCommands();
+    removeDestroyedIDs(projectileIDs);
+    removeDestroyedIDs(alienProjectileIDs);
+
     // Check if all aliens are destroyed
     if (alienIDs.empty()) {
         std::cout << "All aliens destroyed! Moving to the next level..." << std::endl;
 
         // Raise SpawnEvent for the next level
-        EventManager::getInstance().raiseEvent(std::make_shared<SpawnEvent>(playerID, &gameTimeline));
+        world.getEventManager().raiseEvent(SpawnEvent(playerID, &gameTimeline));
 
         // Increase tic rate and reset the game for the next level
         gameTimeline.changeTic(gameTimeline.getTic() + 0.5f);
@@ -397,156 +401,171 @@ void Game2::updateGameObjects() {
     }
 }
 
+// Remove IDs of objects that no longer exist from an ID list, in a single pass
+void Game2::removeDestroyedIDs(std::vector<int>& objectIDs) {
+    auto& propertyManager = world.getPropertyManager();
+    objectIDs.erase(std::remove_if(objectIDs.begin(), objectIDs.end(), [&propertyManager](int objectID) {
+        return !propertyManager.hasObject(objectID);
+        }), objectIDs.end());
+}
+
 // Render all game objects
 void Game2::render() {
     SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255); // Black background
     SDL_RenderClear(renderer);
 
-    // Render the player, aliens, and projectiles
-    renderPlayer(playerID);
-    for (int alienID : alienIDs) {
-        renderAlien(alienID);
-    }
-    for (int projID : projectileIDs) {
-        renderProjectile(projID);
-    }
-    for (int alienProjID : alienProjectileIDs) {
-        renderAlienProjectile(alienProjID);
-    }
+    // Render the player, aliens, and projectiles: every object with a position and a color
+    auto& propertyManager = world.getPropertyManager();
+    propertyManager.view<RectProperty, RenderProperty>().each([this](int objectID, RectProperty& rect, RenderProperty& color) {
+        SDL_Rect objectSDL = { rect.x, rect.y, rect.w, rect.h };
+        SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, 255);
+        SDL_RenderFillRect(renderer, &objectSDL);
+    });
 
     renderLevelText(); // Render level and speed information
 
     SDL_RenderPresent(renderer);
 }
 
-// Render an alien projectile
-void Game2::renderAlienProjectile(int alienProjID) {
-    auto& propertyManager = PropertyManager::getInstance();
-    auto projRect = std::static_pointer_cast<RectProperty>(propertyManager.getProperty(alienProjID, "Rect"));
-    SDL_Rect projSDL = { projRect->x, projRect->y, projRect->w, projRect->h };
-    SDL_SetRenderDrawColor(renderer, 255, 255, 0, 255); // Yellow for alien projectiles
-    SDL_RenderFillRect(renderer, &projSDL);
-}
+// Handle a spawn event for the player
+void Game2::handleSpawn() {
+    std::cout << "Spawn event triggered for object ID: " << playerID << std::endl;
 
-// Render the player object
-void Game2::renderPlayer(int playerID) {
-    auto& propertyManager = PropertyManager::getInstance();
+    // Reset the player to the default spawn position
+    SDL_Point spawnPosition = { SCREEN_WIDTH / 2, SCREEN_HEIGHT - 100 };
+    auto playerRect = world.getPropertyManager().getProperty<RectProperty>(playerID);
+    playerRect->x = spawnPosition.x;
+    playerRect->y = spawnPosition.y;
+    std::cout << "Player respawned at (" << spawnPosition.x << ", " << spawnPosition.y << ")" << std::endl;
+}
 
-    // Check if the player object exists
-    if (!propertyManager.hasObject(playerID)) {
-        // Return silently if the player doesn't exist
-        return;
-    }
+// Handle a death event for the player
+void Game2::handleDeath() {
+    std::cout << "Death event triggered for object ID: " << playerID << std::endl;
 
-    // Retrieve and render the player's rectangle
-    auto playerRect = std::static_pointer_cast<RectProperty>(propertyManager.getProperty(playerID, "Rect"));
-    SDL_Rect playerSDL = { playerRect->x, playerRect->y, playerRect->w, playerRect->h };
-    SDL_SetRenderDrawColor(renderer, 0, 255, 0, 255); // Green for the player
-    SDL_RenderFillRect(renderer, &playerSDL);
+    // If the player is destroyed, reset the game state
+    std::cout << "Player destroyed. Resetting the game..." << std::endl;
+    gameOver = true;
 }
 
-// Render an alien object
-void Game2::renderAlien(int alienID) {
-    auto& propertyManager = PropertyManager::getInstance();
-    auto alienRect = std::static_pointer_cast<RectProperty>(propertyManager.getProperty(alienID, "Rect"));
-    SDL_Rect alienSDL = { alienRect->x, alienRect->y, alienRect->w, alienRect->h };
-    SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255); // Red for aliens
-    SDL_RenderFillRect(renderer, &alienSDL);
-}
+// Handle a death event for an alien
+void Game2::handleAlienDeath(int alienID) {
+    std::cout << "Death event triggered for object ID: " << alienID << std::endl;
+    objectDeathSubscriptions.erase(alienID);
 
-// Render a projectile object
-void Game2::renderProjectile(int projectileID) {
-    auto& propertyManager = PropertyManager::getInstance();
-    auto projRect = std::static_pointer_cast<RectProperty>(propertyManager.getProperty(projectileID, "Rect"));
-    SDL_Rect projSDL = { projRect->x, projRect->y, projRect->w, projRect->h };
-    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255); // White for projectiles
-    SDL_RenderFillRect(renderer, &projSDL);
+    // Aliens hit in update() are already gone; one killed by any other event is removed here
+    auto& propertyManager = world.getPropertyManager();
+    if (propertyManager.hasObject(alienID)) {
+        alienIDs.erase(std::remove(alienIDs.begin(), alienIDs.end(), alienID), alienIDs.end());
+        propertyManager.destroyObject(alienID);
+    }
+    std::cout << "Alien destroyed. Remaining aliens: " << alienIDs.size() << std::endl;
 }
 
-// Handle a spawn event
-void Game2::handleSpawn(int objectID) {
-    std::cout << "Spawn event triggered for object ID: " << objectID << std::endl;
-
-    auto& propertyManager = PropertyManager::getInstance();
-
-    // Find a suitable spawn position (for example, reset the player or an alien)
-    SDL_Point spawnPosition = { SCREEN_WIDTH / 2, SCREEN_HEIGHT - 100 }; // Default spawn position
-    if (objectID == playerID) {
-        // If it's the player, reset to the default spawn position
-        auto playerRect = std::static_pointer_cast<RectProperty>(propertyManager.getProperty(objectID, "Rect"));
-        playerRect->x = spawnPosition.x;
-        playerRect->y = spawnPosition.y;
-        std::cout << "Player respawned at (" << spawnPosition.x << ", " << spawnPosition.y << ")" << std::endl;
-    }
-    else if (std::find(alienIDs.begin(), alienIDs.end(), objectID) != alienIDs.end()) {
-        // If it's an alien, respawn it in a random row
-        int column = rand() % 10; // Assuming 10 columns
-        auto alienRect = std::static_pointer_cast<RectProperty>(propertyManager.getProperty(objectID, "Rect"));
-        alienRect->x = column * (ALIEN_WIDTH + 10) + 50;
-        alienRect->y = 50; // Reset aliens to the top row
-        std::cout << "Alien respawned at (" << alienRect->x << ", " << alienRect->y << ")" << std::endl;
+// Handle a death event for a player projectile
+void Game2::handleProjectileDeath(int projectileID) {
+    // The handler sees every DEATH event; only live player projectiles are handled here. Projectiles
+    // hit in update() are already gone by the time their event is dispatched.
+    auto& propertyManager = world.getPropertyManager();
+    size_t slot = static_cast<size_t>(Entity::getIndex(projectileID));
+    if (projectileID < 0 || slot >= projectileSlots.size() || projectileSlots[slot] != projectileID
+        || !propertyManager.hasObject(projectileID)) {
+        return;
     }
+    std::cout << "Death event triggered for object ID: " << projectileID << std::endl;
+    projectileSlots[slot] = Entity::INVALID_ID;
+
+    projectileIDs.erase(std::remove(projectileIDs.begin(), projectileIDs.end(), projectileID), projectileIDs.end());
+    propertyManager.destroyObject(projectileID);
+    std::cout << "Projectile destroyed." << std::endl;
 }
 
-// Handle a death event
-void Game2::handleDeath(int objectID) {
-    std::cout << "Death event triggered for object ID: " << objectID << std::endl;
+// Step the alien grid, reversing and dropping it at the screen edges
+void Game2::moveAliens() {
+    auto& propertyManager = world.getPropertyManager();
+    bool changeDirection = false;
 
-    auto& propertyManager = PropertyManager::getInstance();
+    for (int alienID : alienIDs) {
+        auto alienRect = propertyManager.getProperty<RectProperty>(alienID);
+        alienRect->x += alienDirection * 10;
 
-    if (objectID == playerID) {
-        // If the player is destroyed, reset the game state
-        std::cout << "Player destroyed. Resetting the game..." << std::endl;
-        gameOver = true;
+        // Check if aliens hit the screen edges
+        if (alienRect->x < 0 || alienRect->x + ALIEN_WIDTH > SCREEN_WIDTH) {
+            changeDirection = true;
+        }
     }
-    else if (std::find(alienIDs.begin(), alienIDs.end(), objectID) != alienIDs.end()) {
-        // Remove the alien from the game
-        alienIDs.erase(std::remove(alienIDs.begin(), alienIDs.end(), objectID), alienIDs.end());
-        propertyManager.destroyObject(objectID);
-        std::cout << "Alien destroyed. Remaining aliens: " << alienIDs.size() << std::endl;
 
-        // Check if all aliens are destroyed
-        if (alienIDs.empty()) {
-            std::cout << "All aliens destroyed. Advancing to the next level..." << std::endl;
-            resetGame();
+    // Reverse direction and move aliens downward if they hit the screen edge
+    if (changeDirection) {
+        alienDirection *= -1;
+        for (int alienID : alienIDs) {
+            auto alienRect = propertyManager.getProperty<RectProperty>(alienID);
+            alienRect->y += 20;
         }
     }
-    else if (std::find(projectileIDs.begin(), projectileIDs.end(), objectID) != projectileIDs.end()) {
-        // Remove the projectile
-        projectileIDs.erase(std::remove(projectileIDs.begin(), projectileIDs.end(), objectID), projectileIDs.end());
-        propertyManager.destroyObject(objectID);
-        std::cout << "Projectile destroyed." << std::endl;
+}
+
+// Fire a projectile from a random alien
+void Game2::fireAlienProjectile() {
+    if (alienIDs.empty()) {
+        return;
     }
+
+    auto& propertyManager = world.getPropertyManager();
+    int randomIndex = rand() % alienIDs.size();
+    int shootingAlienID = alienIDs[randomIndex];
+    auto alienRect = propertyManager.getProperty<RectProperty>(shootingAlienID);
+    int spawnX = alienRect->x + ALIEN_WIDTH / 2 - PROJECTILE_WIDTH / 2;
+    int spawnY = alienRect->y + ALIEN_HEIGHT;
+
+    // Create a projectile from the alien's position
+    int alienProjID = propertyManager.instantiate(alienProjectilePrefab);
+    auto alienProjRect = propertyManager.getProperty<RectProperty>(alienProjID);
+    alienProjRect->x = spawnX;
+    alienProjRect->y = spawnY;
+    alienProjectileIDs.push_back(alienProjID);
+
+    // Raise a SpawnEvent for the new alien projectile
+    world.getEventManager().raiseEvent(SpawnEvent(alienProjID, &gameTimeline));
+}
+
+// Scale a level-1 interval by the level speed
+int64_t Game2::levelDelay(int64_t intervalMs) const {
+    // Game time already runs 1/tic as fast as real time, so dividing by tic twice shortens the
+    // real interval by tic, the same speed-up the rest of the level gets
+    float tic = gameTimeline.getTic();
+    return std::max<int64_t>(1, static_cast<int64_t>(intervalMs / (tic * tic)));
 }
 
 // Reset the game state
 void Game2::resetGame() {
-    auto& propertyManager = PropertyManager::getInstance();
+    auto& propertyManager = world.getPropertyManager();
 
     // Destroy all projectiles
     for (int projID : projectileIDs) {
-        EventManager::getInstance().raiseEvent(std::make_shared<DeathEvent>(projID, &gameTimeline));
+        world.getEventManager().raiseEvent(DeathEvent(projID, &gameTimeline));
         propertyManager.destroyObject(projID);
     }
     projectileIDs.clear();
 
     // Destroy all alien projectiles
     for (int alienProjID : alienProjectileIDs) {
-        EventManager::getInstance().raiseEvent(std::make_shared<DeathEvent>(alienProjID, &gameTimeline));
+        world.getEventManager().raiseEvent(DeathEvent(alienProjID, &gameTimeline));
         propertyManager.destroyObject(alienProjID);
     }
     alienProjectileIDs.clear();
 
     // Destroy all aliens
     for (int alienID : alienIDs) {
-        EventManager::getInstance().raiseEvent(std::make_shared<DeathEvent>(alienID, &gameTimeline));
+        world.getEventManager().raiseEvent(DeathEvent(alienID, &gameTimeline));
         propertyManager.destroyObject(alienID);
     }
     alienIDs.clear();
+    objectDeathSubscriptions.clear();
 
     // Destroy the player object if it exists
     if (propertyManager.hasObject(playerID)) {
-        EventManager::getInstance().raiseEvent(std::make_shared<DeathEvent>(playerID, &gameTimeline));
+        world.getEventManager().raiseEvent(DeathEvent(playerID, &gameTimeline));
         propertyManager.destroyObject(playerID);
     }
 
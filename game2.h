@@ -6,6 +6,7 @@
 #include <mutex>
 #include <memory>
 #include "Timeline.h"
+#include "World.h"
 #include "PropertyManager.h"
 #include "ThreadManager.h"
 #include "EventManager.h"
@@ -13,6 +14,7 @@
 #include "SpawnEvent.h"
 #include "InputEvent.h"
 #include "CollisionEvent.h"
+#include "TimerEvent.h"
 #include <SDL2/SDL_ttf.h>
 
 // Constants for screen dimensions
@@ -27,6 +29,22 @@
 #define PROJECTILE_WIDTH 10     // Width of a projectile
 #define PROJECTILE_HEIGHT 20    // Height of a projectile
 
+// Number of objects (player, aliens and projectiles) reserved up front so spawning never allocates
+#define MAX_GAME_OBJECTS 256
+
+// Snapshot of the player and alien grid, written on first run and loaded at the start of every level
+#define INVADERS_WORLD_FILE "invaders.world"
+
+// Version of createLevelObjects(); bump it whenever the level changes so old snapshots are rebuilt
+#define INVADERS_LAYOUT_VERSION 1
+
+// Longest the event dispatch may run per frame; bursts (such as a level reset) spill over into later frames
+#define EVENT_DISPATCH_BUDGET_US 2000
+
+// Game time between alien steps and between alien shots at level 1; both shrink as the level speeds up
+#define ALIEN_MOVE_INTERVAL_MS 500
+#define ALIEN_SHOOT_INTERVAL_MS 1600
+
 // Forward declarations for properties
 class RectProperty;
 class VelocityProperty;
@@ -41,12 +59,13 @@ class Game2 {
 public:
     /**
      * @brief Constructs a Game2 object with an SDL renderer and ZeroMQ sockets.
+     * @param world The world holding this game's objects and events.
      * @param renderer SDL renderer for drawing the game.
      * @param reqSocket ZeroMQ request socket for sending player position data.
      * @param subSocket ZeroMQ subscriber socket for receiving updates.
      * @param eventReqSocket ZeroMQ socket for sending event data.
      */
-    Game2(SDL_Renderer* renderer, zmq::socket_t& reqSocket, zmq::socket_t& subSocket, zmq::socket_t& eventReqSocket);
+    Game2(World& world, SDL_Renderer* renderer, zmq::socket_t& reqSocket, zmq::socket_t& subSocket, zmq::socket_t& eventReqSocket);
 
     /**
      * @brief Destructor for Game2.
@@ -64,6 +83,11 @@ private:
      */
     void initGameObjects();
 
+    /**
+     * @brief Creates the player and alien grid from code; used when no world snapshot exists yet.
+     */
+    void createLevelObjects();
+
     /**
      * @brief Updates the game state, including object movement and collision checks.
      */
@@ -80,60 +104,69 @@ private:
     void handleEvents();
 
     /**
-     * @brief Handles a spawn event for creating objects like projectiles.
-     * @param objectID ID of the object to spawn.
+     * @brief Handles a spawn event for the player by moving it back to its spawn position.
      */
-    void handleSpawn(int objectID);
+    void handleSpawn();
 
     /**
-     * @brief Handles a death event for objects like projectiles or aliens.
-     * @param objectID ID of the object triggering the death event.
+     * @brief Handles a death event for the player.
      */
-    void handleDeath(int objectID);
+    void handleDeath();
 
     /**
-     * @brief Resets the game state, including reinitializing all objects and resetting the timeline.
+     * @brief Handles a death event for an alien.
+     * @param alienID ID of the alien that died.
      */
-    void resetGame();
+    void handleAlienDeath(int alienID);
 
     /**
-     * @brief Sends the player's position to the server.
+     * @brief Handles a death event for a player projectile; events about other objects are ignored.
+     * @param projectileID ID of the object that died.
      */
-    void sendPlayerUpdate();
+    void handleProjectileDeath(int projectileID);
 
     /**
-     * @brief Receives updates from the server, including other players' positions.
+     * @brief Steps the alien grid sideways, dropping it a row and reversing when it reaches a screen edge.
      */
-    void receiveServerUpdates();
+    void moveAliens();
 
     /**
-     * @brief Renders all game objects, including the player, aliens, and projectiles.
+     * @brief Fires a projectile from a randomly chosen alien.
      */
-    void render();
+    void fireAlienProjectile();
 
     /**
-     * @brief Renders the player character.
-     * @param playerID ID of the player to render.
+     * @brief Converts a level-1 interval into the timer delay for the current level speed.
+     * @param intervalMs The interval in milliseconds at level 1.
+     * @return The delay in milliseconds on the game timeline.
      */
-    void renderPlayer(int playerID);
+    int64_t levelDelay(int64_t intervalMs) const;
 
     /**
-     * @brief Renders an alien object.
-     * @param alienID ID of the alien to render.
+     * @brief Resets the game state, including reinitializing all objects and resetting the timeline.
      */
-    void renderAlien(int alienID);
+    void resetGame();
 
     /**
-     * @brief Renders a projectile object.
-     * @param projectileID ID of the projectile to render.
+     * @brief Sends the player's position to the server.
      */
-    void renderProjectile(int projectileID);
+    void sendPlayerUpdate();
 
     /**
-     * @brief Renders an alien projectile object.
-     * @param alienProjID ID of the alien projectile to render.
+     * @brief Receives updates from the server, including other players' positions.
      */
-    void renderAlienProjectile(int alienProjID);
+    void receiveServerUpdates();
+
+    /**
+     * @brief Removes the IDs of destroyed objects from an ID list.
+     * @param objectIDs The list of object IDs to prune.
+     */
+    void removeDestroyedIDs(std::vector<int>& objectIDs);
+
+    /**
+     * @brief Renders all game objects, including the player, aliens, and projectiles.
+     */
+    void render();
 
     /**
      * @brief Renders the current level text on the screen.
@@ -145,6 +178,14 @@ private:
      */
     void fireProjectile();
 
+    World& world;                     // World holding this game's objects and events
+    Subscription spawnSubscription;   // Keeps the player's SPAWN handler registered (replaced on every reset)
+    Subscription deathSubscription;   // Keeps the player's DEATH handler registered (replaced on every reset)
+    Subscription projectileDeathSubscription; // Keeps the DEATH handler shared by all player projectiles registered
+    std::unordered_map<int, Subscription> objectDeathSubscriptions; // DEATH handlers of live aliens, by object ID
+    Subscription alienMoveSubscription;  // Keeps the alien movement TIMER handler registered (replaced on every reset)
+    Subscription alienShootSubscription; // Keeps the alien shooting TIMER handler registered (replaced on every reset)
+
     SDL_Renderer* renderer;           // SDL renderer for drawing the game
     SDL_Event e;                      // SDL event object for input handling
     zmq::socket_t& reqSocket;         // ZeroMQ request socket for sending player data
@@ -154,13 +195,20 @@ private:
     int playerID;                     // ID of the player object
     std::vector<int> alienIDs;        // IDs of alien objects
     std::vector<int> projectileIDs;   // IDs of projectile objects
+    std::vector<int> projectileSlots; // Player projectile ID last fired from each slot index; stale entries never match a live object's ID
     std::vector<int> alienProjectileIDs; // IDs of alien projectile objects
+    Prefab alienPrefab;               // Property bundle every alien starts with
+    Prefab projectilePrefab;          // Property bundle of the player's projectiles
+    Prefab alienProjectilePrefab;     // Property bundle of the aliens' projectiles
     std::unordered_map<int, PlayerPosition> allPlayers; // Map of all players' positions
 
     bool quit;                        // Whether the game is running
     bool gameOver;                    // Whether the game is over
     int clientId;                     // Unique client ID assigned by the server
     int level = 1;                    // Current game level
+    bool isSpacePressed = false;      // Whether the space bar was held last frame (fire once per press)
+    int alienDirection = 1;           // 1 for moving right, -1 for moving left
+    int nextTimerID = 0;              // Next free timer ID; each reset takes fresh ones so stale timers reach no handler
 
     TTF_Font* font;                   // Font for rendering text
     SDL_Texture* levelTexture;        // Texture for the level text
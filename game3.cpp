@@ -9,8 +9,8 @@
 #include <iostream>
 
 // Constructor to initialize the game
-Game3::Game3(SDL_Renderer* renderer, zmq::socket_t& reqSocket, zmq::socket_t& subSocket, zmq::socket_t& eventReqSocket)
-    : renderer(renderer), reqSocket(reqSocket), subSocket(subSocket), eventReqSocket(eventReqSocket), quit(false), gameOver(false), score(0), gameTimeline(nullptr, INITIAL_SPEED), font(nullptr), scoreTexture(nullptr), speedTexture(nullptr) {
+Game3::Game3(World& world, SDL_Renderer* renderer, zmq::socket_t& reqSocket, zmq::socket_t& subSocket, zmq::socket_t& eventReqSocket)
+    : world(world), renderer(renderer), reqSocket(reqSocket), subSocket(subSocket), eventReqSocket(eventReqSocket), quit(false), gameOver(false), score(0), clientId(-1), foodID(Entity::INVALID_ID), gameTimeline(nullptr, INITIAL_SPEED), font(nullptr), scoreTexture(nullptr), speedTexture(nullptr) {
     srand(static_cast<unsigned>(time(nullptr))); // Seed for random number generation
 
     // Initialize SDL_ttf for rendering text
@@ -47,19 +47,7 @@ Game3::~Game3() {
 
 // Initialize game objects like the snake and food
 void Game3::initGameObjects() {
-    auto& propertyManager = PropertyManager::getInstance();
-    auto& eventManager = EventManager::getInstance();
-
-    // Register event handlers for SPAWN and DEATH events
-    eventManager.registerHandler(SPAWN, [this](std::shared_ptr<Event> event) {
-        auto spawnEvent = std::static_pointer_cast<SpawnEvent>(event);
-        handleSpawn(spawnEvent->getObjectID());
-        });
-
-    eventManager.registerHandler(DEATH, [this](std::shared_ptr<Event> event) {
-        auto deathEvent = std::static_pointer_cast<DeathEvent>(event);
-        handleDeath(deathEvent->getObjectID());
-        });
+    auto& propertyManager = world.getPropertyManager();
 
     // Clear the snake body and reset its position
     snakeBody.clear();
@@ -74,7 +62,7 @@ void Game3::initGameObjects() {
 
 // Place food at a random position, ensuring it does not overlap with the snake
 void Game3::placeFood() {
-    auto& propertyManager = PropertyManager::getInstance();
+    auto& propertyManager = world.getPropertyManager();
 
     SDL_Point newFoodPosition;
     do {
@@ -87,14 +75,25 @@ void Game3::placeFood() {
     }
 
     foodID = propertyManager.createObject();
-    propertyManager.addProperty(foodID, "Rect", std::make_shared<RectProperty>(
+    propertyManager.addProperty(foodID, RectProperty(
         newFoodPosition.x * GRID_SIZE, newFoodPosition.y * GRID_SIZE, GRID_SIZE, GRID_SIZE));
-    propertyManager.addProperty(foodID, "Render", std::make_shared<RenderProperty>(255, 0, 0));
+    propertyManager.addProperty(foodID, RenderProperty(255, 0, 0));
 
     std::cout << "New food placed at: (" << newFoodPosition.x << ", " << newFoodPosition.y << ")" << std::endl;
 
+    // Listen for the SPAWN and DEATH events of this food object only; replacing the
+    // subscriptions drops the handlers of the previous food
+    auto& eventManager = world.getEventManager();
+    spawnSubscription = eventManager.subscribe(SPAWN, foodID, [this](const Event&) {
+        handleSpawn();
+        });
+
+    deathSubscription = eventManager.subscribe(DEATH, foodID, [this](const Event&) {
+        handleDeath();
+        });
+
     // Raise spawn event for food
-    EventManager::getInstance().raiseEvent(std::make_shared<SpawnEvent>(foodID, &gameTimeline));
+    world.getEventManager().raiseEvent(SpawnEvent(foodID, &gameTimeline));
 }
 
 
@@ -117,7 +116,7 @@ void Game3::run() {
         }
 
         handleEvents(); // Handle player input
-        EventManager::getInstance().dispatchEvents(); // Process pending events
+        world.getEventManager().dispatchEvents(gameTimeline.getTime()); // Process pending events
         update();       // Update game state
         render();       // Render game objects
 
@@ -163,12 +162,12 @@ void Game3::update() {
     // Add the new head position to the snake
     snakeBody.push_front(newHead);
 
-    auto& propertyManager = PropertyManager::getInstance();
-    auto foodRect = std::static_pointer_cast<RectProperty>(propertyManager.getProperty(foodID, "Rect"));
+    auto& propertyManager = world.getPropertyManager();
+    auto foodRect = propertyManager.getProperty<RectProperty>(foodID);
     if (newHead.x == foodRect->x / GRID_SIZE && newHead.y == foodRect->y / GRID_SIZE) {
         score += FOOD_SCORE; // Increase the score
         //placeFood();         // Place a new food item
-		EventManager::getInstance().raiseEvent(std::make_shared<DeathEvent>(foodID, &gameTimeline));
+		world.getEventManager().raiseEvent(DeathEvent(foodID, &gameTimeline));
         float newTic = gameTimeline.getTic() + 0.05f; // Speed up the game slightly
         gameTimeline.changeTic(newTic);
     }
@@ -192,8 +191,8 @@ void Game3::render() {
     }
 
     // Render the food
-    auto& propertyManager = PropertyManager::getInstance();
-    auto foodRect = std::static_pointer_cast<RectProperty>(propertyManager.getProperty(foodID, "Rect"));
+    auto& propertyManager = world.getPropertyManager();
+    auto foodRect = propertyManager.getProperty<RectProperty>(foodID);
     SDL_Rect sdlFoodRect = { foodRect->x, foodRect->y, foodRect->w, foodRect->h };
     SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255); // Red food
     SDL_RenderFillRect(renderer, &sdlFoodRect);
@@ -236,8 +235,6 @@ void Game3::renderScoreText() {
 
 // Send player updates to the server
 void Game3::sendPlayerUpdate() {
-    static int clientId = -1;
-
     struct PlayerState {
         int x, y;        // Snake head position
         int score;       // Current score
@@ -261,30 +258,21 @@ void Game3::sendPlayerUpdate() {
     }
 }
 
-// Handle spawn events
-void Game3::handleSpawn(int objectID) {
-    std::cout << "Spawn event triggered for object ID: " << objectID << std::endl;
-
-    // Ensure the spawned object is food
-    if (objectID == foodID) {
-        std::cout << "Spawn event handled for food object. Food ID: " << objectID << std::endl;
-    }
-    else {
-        std::cerr << "Unhandled spawn event for object ID: " << objectID << std::endl;
-    }
+// Handle spawn events for the food
+void Game3::handleSpawn() {
+    std::cout << "Spawn event triggered for object ID: " << foodID << std::endl;
+    std::cout << "Spawn event handled for food object. Food ID: " << foodID << std::endl;
 }
 
-// Handle death events
-void Game3::handleDeath(int objectID) {
-    if (objectID == foodID) {
-        std::cout << "Death event for food. Handling food respawn." << std::endl;
-        placeFood();
-    }
+// Handle death events for the food
+void Game3::handleDeath() {
+    std::cout << "Death event for food. Handling food respawn." << std::endl;
+    placeFood();
 }
 
 // Reset the game
 void Game3::resetGame() {
-    auto& propertyManager = PropertyManager::getInstance();
+    auto& propertyManager = world.getPropertyManager();
 
     // Clear the snake body
     snakeBody.clear();
@@ -298,7 +286,7 @@ void Game3::resetGame() {
     score = 0;
     gameOver = false;
     // raise death event
-	EventManager::getInstance().raiseEvent(std::make_shared<DeathEvent>(foodID, &gameTimeline));
+	world.getEventManager().raiseEvent(DeathEvent(foodID, &gameTimeline));
     gameTimeline.changeTic(INITIAL_SPEED); // Reset the speed
 
     // Reinitialize the snake
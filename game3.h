@@ -6,6 +6,7 @@
 #include <unordered_map>
 #include <memory>
 #include "Timeline.h"
+#include "World.h"
 #include "PropertyManager.h"
 #include "ThreadManager.h"
 #include "EventManager.h"
@@ -38,12 +39,13 @@ class Game3 {
 public:
     /**
      * @brief Constructs a Game3 object with an SDL renderer and ZeroMQ sockets.
+     * @param world The world holding this game's objects and events.
      * @param renderer SDL renderer for drawing the game.
      * @param reqSocket ZeroMQ request socket for sending player position data.
      * @param subSocket ZeroMQ subscriber socket for receiving updates.
      * @param eventReqSocket ZeroMQ socket for sending event data.
      */
-    Game3(SDL_Renderer* renderer, zmq::socket_t& reqSocket, zmq::socket_t& subSocket, zmq::socket_t& eventReqSocket);
+    Game3(World& world, SDL_Renderer* renderer, zmq::socket_t& reqSocket, zmq::socket_t& subSocket, zmq::socket_t& eventReqSocket);
 
     /**
      * @brief Destructor for Game3.
@@ -61,9 +63,15 @@ private:
      */
     void initGameObjects();
 
-    void handleSpawn(int objectID);
+    /**
+     * @brief Handles a spawn event for the current food object.
+     */
+    void handleSpawn();
 
-    void handleDeath(int objectID);
+    /**
+     * @brief Handles a death event for the current food object by placing new food.
+     */
+    void handleDeath();
 
     /**
      * @brief Places food randomly on the grid.
@@ -109,6 +117,10 @@ private:
      */
     void renderScoreText();
 
+    World& world;                     // World holding this game's objects and events
+    Subscription spawnSubscription;   // Keeps the current food's SPAWN handler registered
+    Subscription deathSubscription;   // Keeps the current food's DEATH handler registered
+
     SDL_Renderer* renderer;           // SDL renderer for drawing the game
     SDL_Event e;                      // SDL event object for input handling
     zmq::socket_t& reqSocket;         // ZeroMQ request socket for sending player data
@@ -126,7 +138,7 @@ private:
     int score;                        // Current score
     int clientId;                     // Unique client ID assigned by the server
     bool resetting;
-    int foodID;
+    int foodID;                       // ID of the current food object (Entity::INVALID_ID before the first placement)
 
     TTF_Font* font;                   // Font for rendering score text
     SDL_Texture* scoreTexture;        // Texture for the score text
@@ -6,16 +6,36 @@
 int playerId = -1;
 
 int main(int argc, char* args[]) {
+    EventJournal journal;  // Records the session's events when started with --record-events <file>
+    EventJournalReader replayJournal;  // Session played back instead of the game loop when started with --replay-events <file>
+    bool replaying = false;
+    const char* statsFile = nullptr;  // Event statistics report written on exit when started with --event-stats <file>
+    World world;  // Owns the game's objects and event handlers
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(args[i], "--record-events") == 0 && journal.open(args[i + 1])) {
+            world.getEventManager().setJournal(&journal);
+        }
+        else if (strcmp(args[i], "--replay-events") == 0 && replayJournal.open(args[i + 1])) {
+            replaying = true;
+        }
+        else if (strcmp(args[i], "--event-stats") == 0) {
+            statsFile = args[i + 1];
+            world.getEventManager().setStatsEnabled(true);
+        }
+    }
+
     SDL_Window* window = nullptr;
     SDL_Renderer* renderer = nullptr;
 
-    // Initialize SDL and create window and renderer
-    init(window, renderer, SCREEN_WIDTH, SCREEN_HEIGHT);
+    // Initialize SDL and create window and renderer; a replay runs headless and needs neither
+    if (!replaying) {
+        init(window, renderer, SCREEN_WIDTH, SCREEN_HEIGHT);
 
-    // Check if initialization of SDL, window, or renderer failed
-    if (window == nullptr || renderer == nullptr) {
-        std::cerr << "Initialization failed!" << std::endl;
-        return -1;
+        // Check if initialization of SDL, window, or renderer failed
+        if (window == nullptr || renderer == nullptr) {
+            std::cerr << "Initialization failed!" << std::endl;
+            return -1;
+        }
     }
 
     // Initialize ZeroMQ for client communication
@@ -33,11 +53,21 @@ int main(int argc, char* args[]) {
 
     // Create an instance of the Game class, passing the SDL renderer and ZeroMQ sockets
 	// Change accordingly; if using Game2, replace Game with Game2; 
-    // If using Game3, replace Game with Game3
-    Game game(renderer, reqSocket, subSocket, eventReqSocket);
+    // If using Game3, replace Game with Game3 (neither takes the event bus; both take eventReqSocket instead)
+    NetworkEventBus eventBus(world.getEventManager(), context);  // Replicates events through the server's relay (ports 5558/5559)
+    Game game(world, renderer, reqSocket, subSocket, eventBus);
 
-    // Start the game loop
-    game.run();
+    // Start the game loop, or play back a recorded session
+    if (replaying) {
+        game.replay(replayJournal);
+    }
+    else {
+        game.run();
+    }
+
+    if (statsFile) {
+        world.getEventManager().getStats().writeReport(statsFile);
+    }
 
     // Clean up ZeroMQ and SDL resources after the game loop ends
     reqSocket.close();  // Close the request socket
@@ -45,7 +75,9 @@ int main(int argc, char* args[]) {
     eventReqSocket.close();  // Close the event request socket
     context.shutdown();  // Shutdown the ZeroMQ context
 
-    close(window, renderer);  // Clean up SDL resources by destroying the window and renderer
+    if (!replaying) {
+        close(window, renderer);  // Clean up SDL resources by destroying the window and renderer
+    }
 
     return 0;  // Exit the program successfully
 }